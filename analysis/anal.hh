@@ -2,7 +2,9 @@
 #include "Particle.hh"
 #include "Physics.hh"
 #include "ProgressBar.cpp"
+#include "EventChain.hh"
 #include "BaseHistograms.hh"
+#include "AcceptanceTable.hh"
 
 #include <array>
 #include <vector>
@@ -19,6 +21,8 @@ namespace fs = std::filesystem;
 #include "TChain.h"
 #include "TH1D.h"
 #include "TH2D.h"
+#include "TTree.h"
+#include "TEntryList.h"
 
 const int NDECAYS = 10; // 10 decay events generated from each primary event
 
@@ -41,7 +45,7 @@ struct AMD
 };
 
 AMD amd;
-void Initialize_TChain(TChain *&chain, const std::vector<std::string> &input_pths, const std::string &analysis = "filtered", const std::string &mode = "3");
+void Initialize_TChain(EventChain *&chain, const std::vector<std::string> &input_pths, const std::string &analysis = "filtered", const std::string &mode = "3");
 
 class ArgumentParser
 {
@@ -56,6 +60,13 @@ public:
     std::array<int, 2> cut_on_multiplicity = {0, 128};
     std::array<double, 2> cut_on_impact_parameter = {0., 3.};
 
+    // acceptance table from filter_e15190 -a, weights the particles of raw events instead of filtering them
+    std::string path_acceptance = "";
+    std::string detector = "hira";
+
+    // input files are HiRA skims from filter_e15190 -s
+    bool skim = false;
+
     std::string beam;
     std::string target;
     int beamA, beamZ, targetA, targetZ, beam_energy;
@@ -72,12 +83,15 @@ public:
             {"table", required_argument, 0, 't'},
             {"cut_on_multiplicity", required_argument, 0, 'c'},
             {"cut_on_impact_parameter", required_argument, 0, 'b'},
+            {"acceptance", required_argument, 0, 'a'},
+            {"detector", required_argument, 0, 'd'},
+            {"skim", no_argument, 0, 's'},
             {0, 0, 0, 0},
         };
 
         int option_index = 0;
         int opt;
-        while ((opt = getopt_long(argc, argv, "hr:i:o:c:b:t:m:", options.data(), &option_index)) != -1)
+        while ((opt = getopt_long(argc, argv, "hr:i:o:c:b:t:m:a:d:s", options.data(), &option_index)) != -1)
         {
             switch (opt)
             {
@@ -128,6 +142,21 @@ public:
                 this->table = optarg;
                 break;
             }
+            case 'a':
+            {
+                this->path_acceptance = optarg;
+                break;
+            }
+            case 'd':
+            {
+                this->detector = optarg;
+                break;
+            }
+            case 's':
+            {
+                this->skim = true;
+                break;
+            }
             case '?':
             {
                 std::cout << "Got unknown option." << std::endl;
@@ -153,6 +182,18 @@ public:
             exit(1);
         }
 
+        if (this->skim && (this->mode != "filtered" || this->table != "3"))
+        {
+            std::cout << "HiRA skims (-s) hold filtered events of table 3." << std::endl;
+            exit(1);
+        }
+
+        if (!this->path_acceptance.empty() && (this->mode != "raw" || !fs::exists(this->path_acceptance)))
+        {
+            std::cout << "Acceptance weights need raw mode and an existing acceptance table." << std::endl;
+            exit(1);
+        }
+
         for (auto f : this->input_files)
         {
             if (!fs::exists(f))
@@ -166,12 +207,15 @@ public:
     {
         const char *msg = R"(
             -r      reaction tag, e.g. `Ca48Ni64E140`
-            -i      a list of input ROOT files, separated by space.
+            -i      a list of input ROOT files or columnar files (.amdc) from amd2root, separated by space.
             -o      ROOT file output path.
             -c      cut on uball charged particles, e.g. `0 128`
             -b      cut on impact parameter, e.g. `0. 3.`
             -m      mode, either `filtered` or `raw`
             -t      table number, either `21` or `3` (implement 21t later)
+            -a      acceptance table (.acc) from filter_e15190 -a; in raw mode, every particle is weighted by its efficiency.
+            -d      detector of the acceptance table used by -a, `hira` (default) or `uball`.
+            -s      the inputs are HiRA skims (`*_hira.root`) from filter_e15190 -s; only the events within the cut on uball multiplicity are read.
             -h      Print help message.
         )";
         std::cout << msg << std::endl;
@@ -232,7 +276,7 @@ protected:
     std::vector<option> options;
 };
 
-void Initialize_TChain(TChain *&chain, const std::vector<std::string> &input_pths, const std::string &analysis, const std::string &mode)
+void Initialize_TChain(EventChain *&chain, const std::vector<std::string> &input_pths, const std::string &analysis, const std::string &mode)
 {
     for (auto &pth : input_pths)
     {
@@ -1,14 +1,14 @@
 #include "anal.hh"
 
 void Replace_Errorbars(ImpactParameterMultiplicity *&hist, ImpactParameterMultiplicity *&hist_one_decay);
-void analyze_table3(TChain *&chain, ImpactParameterMultiplicity *&hist, const ArgumentParser &argparser);
-void analyze_table21(TChain *&chain, ImpactParameterMultiplicity *&hist, const ArgumentParser &argparser);
+void analyze_table3(EventChain *&chain, ImpactParameterMultiplicity *&hist, const ArgumentParser &argparser);
+void analyze_table21(EventChain *&chain, ImpactParameterMultiplicity *&hist, const ArgumentParser &argparser);
 
 int main(int argc, char *argv[])
 {
     ArgumentParser argparser(argc, argv);
 
-    TChain *chain = new TChain("AMD");
+    EventChain *chain = new EventChain("AMD");
     Initialize_TChain(chain, argparser.input_files, argparser.mode, argparser.table);
 
     ImpactParameterMultiplicity *hist = new ImpactParameterMultiplicity(
@@ -31,7 +31,7 @@ int main(int argc, char *argv[])
     outputfile->Close();
 }
 
-void analyze_table3(TChain *&chain, ImpactParameterMultiplicity *&hist, const ArgumentParser &argparser)
+void analyze_table3(EventChain *&chain, ImpactParameterMultiplicity *&hist, const ArgumentParser &argparser)
 {
     ImpactParameterMultiplicity *hist_one_decay = new ImpactParameterMultiplicity("table3_one_decay");
     for (int ievt = 0; ievt < chain->GetEntries(); ievt++)
@@ -67,7 +67,7 @@ void analyze_table3(TChain *&chain, ImpactParameterMultiplicity *&hist, const Ar
     return;
 }
 
-void analyze_table21(TChain *&chain, ImpactParameterMultiplicity *&hist, const ArgumentParser &argparser)
+void analyze_table21(EventChain *&chain, ImpactParameterMultiplicity *&hist, const ArgumentParser &argparser)
 {
     for (int ievt = 0; ievt < chain->GetEntries(); ievt++)
     {
@@ -10,7 +10,7 @@ int main(int argc, char *argv[])
         std::exit(1);
     }
 
-    TChain *chain = new TChain("AMD");
+    EventChain *chain = new EventChain("AMD");
     Initialize_TChain(chain, argparser.input_files, argparser.mode, argparser.table);
 
     double beam_mass = ame->GetMass(argparser.beamZ, argparser.beamA);
@@ -21,6 +21,7 @@ int main(int argc, char *argv[])
     PmagEmissionTime *hist_pmag_time = new PmagEmissionTime("table21t");
     RmagEmissionTime *hist_rmag_time = new RmagEmissionTime("table21t");
 
+    EventKinematics kinematics(EventKinematics::CMS, EventKinematics::Kinergy, betacms, rapidity_beam);
     for (int ievt = 0; ievt < chain->GetEntries(); ievt++)
     {
         chain->GetEntry(ievt);
@@ -29,13 +30,11 @@ int main(int argc, char *argv[])
         {
             continue;
         }
+        kinematics.Fill(amd.multi, amd.N.data(), amd.Z.data(), amd.px.data(), amd.py.data(), amd.pz.data(), *ame);
+        kinematics.SetSpaceTime(amd.x.data(), amd.y.data(), amd.z.data(), amd.t.data());
         for (int ip = 0; ip < amd.multi; ip++)
         {
-            double A = amd.N[ip] + amd.Z[ip];
-            double mass = ame->GetMass(amd.Z[ip], A);
-            Particle particle(amd.N[ip], amd.Z[ip], amd.px[ip], amd.py[ip], amd.pz[ip], mass);
-            particle.SetXYZT(amd.x[ip], amd.y[ip], amd.z[ip], amd.t[ip], "cms");
-            particle.Initialize(betacms, rapidity_beam);
+            Particle particle(kinematics, ip);
             hist_pmag_time->Fill(particle, 1.);
             hist_rmag_time->Fill(particle, 1.);
         }
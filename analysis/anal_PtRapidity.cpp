@@ -1,20 +1,45 @@
 #include "anal.hh"
 
 void Replace_Errorbars(PtRapidity *&hist, PtRapidity *&hist_one_decay);
-void analyze_table3(TChain *&chain, PtRapidity *&hist, const ArgumentParser &argparser);
-void analyze_table21(TChain *&chain, PtRapidity *&hist, const ArgumentParser &argparser);
+void analyze_table3(EventChain *&chain, PtRapidity *&hist, const ArgumentParser &argparser);
+void analyze_table21(EventChain *&chain, PtRapidity *&hist, const ArgumentParser &argparser);
+void analyze_table3_skim(PtRapidity *&hist, const ArgumentParser &argparser);
+double AcceptanceWeight(const Particle &particle);
 
 AME *ame;
+AcceptanceTable *acceptance = nullptr;
+int acceptance_detector;
 int main(int argc, char *argv[])
 {
     ame = new AME();
     ArgumentParser argparser(argc, argv);
+    if (!argparser.path_acceptance.empty())
+    {
+        acceptance = new AcceptanceTable(argparser.path_acceptance);
+        if (acceptance->GetReaction() != argparser.reaction)
+        {
+            std::string msg = Form("acceptance table %s is of %s, not %s", argparser.path_acceptance.c_str(), acceptance->GetReaction().c_str(), argparser.reaction.c_str());
+            throw std::invalid_argument(msg.c_str());
+        }
+        std::string changed = acceptance->FindChangedInput();
+        if (!changed.empty())
+        {
+            std::string msg = Form("acceptance table %s is older than %s, rebuild it with filter_e15190 -a", argparser.path_acceptance.c_str(), changed.c_str());
+            throw std::invalid_argument(msg.c_str());
+        }
+        acceptance_detector = acceptance->GetDetectorID(argparser.detector);
+    }
 
-    TChain *chain = new TChain("AMD");
+    EventChain *chain = new EventChain("AMD");
     Initialize_TChain(chain, argparser.input_files, argparser.mode, argparser.table);
 
     PtRapidity *hist = 0;
-    if (argparser.table == "3")
+    if (argparser.skim)
+    {
+        hist = new PtRapidity("secondary");
+        analyze_table3_skim(hist, argparser);
+    }
+    else if (argparser.table == "3")
     {
         hist = new PtRapidity("secondary");
         analyze_table3(chain, hist, argparser);
@@ -32,7 +57,7 @@ int main(int argc, char *argv[])
     outputfile->Write();
 }
 
-void analyze_table3(TChain *&chain, PtRapidity *&hist, const ArgumentParser &argparser)
+void analyze_table3(EventChain *&chain, PtRapidity *&hist, const ArgumentParser &argparser)
 {
     PtRapidity *hist_one_decay = new PtRapidity("secondary_one_decay");
     double beam_mass = ame->GetMass(argparser.beamZ, argparser.beamA);
@@ -44,22 +69,22 @@ void analyze_table3(TChain *&chain, PtRapidity *&hist, const ArgumentParser &arg
     double norm = 0.;
     double norm_one_decay = 0.;
 
+    // filtered events are in the lab frame, raw events in the cms frame
+    EventKinematics kinematics(argparser.mode == "filtered" ? EventKinematics::LAB : EventKinematics::CMS, EventKinematics::All, betacms, rapidity_beam);
+
     ProgressBar bar(nevents, argparser.reaction);
     for (int ievt = 0; ievt < nevents; ievt++)
     {
         chain->GetEntry(ievt);
         int multi;
-        std::string frame = "";
         if (argparser.mode == "filtered")
         {
             multi = amd.Nc;
-            frame = "lab";
         }
 
         else if (argparser.mode == "raw")
         {
             multi = amd.multi;
-            frame = "cms";
         }
 
         if (multi >= argparser.cut_on_multiplicity[0] && multi <= argparser.cut_on_multiplicity[1] && amd.b >= argparser.cut_on_impact_parameter[0] && amd.b <= argparser.cut_on_impact_parameter[1])
@@ -76,19 +101,18 @@ void analyze_table3(TChain *&chain, PtRapidity *&hist, const ArgumentParser &arg
             continue;
         }
 
+        // the momenta of table3 are of the whole fragment
+        kinematics.Fill(amd.multi, amd.N.data(), amd.Z.data(), amd.px.data(), amd.py.data(), amd.pz.data(), *ame, false);
         for (int i = 0; i < amd.multi; i++)
         {
-            double A = amd.N[i] + amd.Z[i];
-            double mass = ame->GetMass(amd.Z[i], A);
-
-            Particle particle(amd.N[i], amd.Z[i], amd.px[i] / A, amd.py[i] / A, amd.pz[i] / A, mass, frame);
-            particle.Initialize(betacms, rapidity_beam);
+            Particle particle(kinematics, i);
 
+            double weight = AcceptanceWeight(particle);
             if (ievt < nevents / NDECAYS)
             {
-                hist_one_decay->Fill(particle, 1.);
+                hist_one_decay->Fill(particle, weight);
             }
-            hist->Fill(particle, 1. / NDECAYS);
+            hist->Fill(particle, weight / NDECAYS);
         }
         bar.Update();
     }
@@ -97,7 +121,112 @@ void analyze_table3(TChain *&chain, PtRapidity *&hist, const ArgumentParser &arg
     Replace_Errorbars(hist, hist_one_decay);
 }
 
-void analyze_table21(TChain *&chain, PtRapidity *&hist, const ArgumentParser &argparser)
+/**
+ * @brief Same as analyze_table3 in filtered mode, on the HiRA skims written by filter_e15190 -s.
+ *
+ * The normalization is counted from the "events" tree of each skim, and only the entries of the TEntryLists of the uball
+ * multiplicities within the cut are read. The entry in the full tree decides the one-decay histograms, as in analyze_table3.
+ */
+void analyze_table3_skim(PtRapidity *&hist, const ArgumentParser &argparser)
+{
+    PtRapidity *hist_one_decay = new PtRapidity("secondary_one_decay");
+    double beam_mass = ame->GetMass(argparser.beamZ, argparser.beamA);
+    double target_mass = ame->GetMass(argparser.targetZ, argparser.targetA);
+    double betacms = Physics::GetReactionBeta(beam_mass, target_mass, argparser.beam_energy, argparser.beamA);
+    double rapidity_beam = Physics::GetBeamRapidity(beam_mass, target_mass, argparser.beam_energy, argparser.beamA);
+
+    // first entry of each file in the chain of the full trees
+    std::vector<long> offsets;
+    long nevents = 0;
+    for (auto &path : argparser.input_files)
+    {
+        TFile *file = new TFile(path.c_str(), "READ");
+        TTree *events = file->Get<TTree>("events");
+        if (events == nullptr)
+        {
+            std::string msg = Form("%s is not a HiRA skim.", path.c_str());
+            throw std::invalid_argument(msg.c_str());
+        }
+        offsets.push_back(nevents);
+        nevents += events->GetEntries();
+        file->Close();
+        delete file;
+    }
+
+    double norm = 0.;
+    double norm_one_decay = 0.;
+    EventKinematics kinematics(EventKinematics::LAB, EventKinematics::All, betacms, rapidity_beam);
+    auto pass_cut = [&argparser](const int &multi, const double &b)
+    {
+        return multi >= argparser.cut_on_multiplicity[0] && multi <= argparser.cut_on_multiplicity[1] && b >= argparser.cut_on_impact_parameter[0] && b <= argparser.cut_on_impact_parameter[1];
+    };
+
+    ProgressBar bar(argparser.input_files.size(), argparser.reaction);
+    for (unsigned int ifile = 0; ifile < argparser.input_files.size(); ifile++)
+    {
+        const std::string &path = argparser.input_files[ifile];
+        TFile *file = new TFile(path.c_str(), "READ");
+        TTree *events = file->Get<TTree>("events");
+        int multi;
+        double b;
+        events->SetBranchAddress("uball_multi", &multi);
+        events->SetBranchAddress("b", &b);
+        for (long i = 0; i < events->GetEntries(); i++)
+        {
+            events->GetEntry(i);
+            if (pass_cut(multi, b))
+            {
+                norm += 1. / NDECAYS;
+                norm_one_decay += (offsets[ifile] + i < nevents / NDECAYS) ? 1. : 0.;
+            }
+        }
+
+        // skim entries of the multiplicities within the cut, read in file order
+        std::vector<long> entries;
+        for (int m = argparser.cut_on_multiplicity[0]; m <= argparser.cut_on_multiplicity[1]; m++)
+        {
+            TEntryList *list = file->Get<TEntryList>(Form("uball_multi_%d", m));
+            for (long j = 0; list != nullptr && j < list->GetN(); j++)
+            {
+                entries.push_back(list->GetEntry(j));
+            }
+        }
+        std::sort(entries.begin(), entries.end());
+        file->Close();
+        delete file;
+
+        EventChain *chain = new EventChain("AMD");
+        Initialize_TChain(chain, {path}, "filtered", "3");
+        int entry;
+        chain->SetBranchAddress("entry", &entry);
+        for (auto &ientry : entries)
+        {
+            chain->GetEntry(ientry);
+            if (!pass_cut(amd.Nc, amd.b))
+            {
+                continue;
+            }
+            bool one_decay = offsets[ifile] + entry < nevents / NDECAYS;
+            kinematics.Fill(amd.multi, amd.N.data(), amd.Z.data(), amd.px.data(), amd.py.data(), amd.pz.data(), *ame, false);
+            for (int i = 0; i < amd.multi; i++)
+            {
+                Particle particle(kinematics, i);
+                if (one_decay)
+                {
+                    hist_one_decay->Fill(particle, 1.);
+                }
+                hist->Fill(particle, 1. / NDECAYS);
+            }
+        }
+        delete chain;
+        bar.Update();
+    }
+    hist->Normalize(norm);
+    hist_one_decay->Normalize(norm_one_decay);
+    Replace_Errorbars(hist, hist_one_decay);
+}
+
+void analyze_table21(EventChain *&chain, PtRapidity *&hist, const ArgumentParser &argparser)
 {
     double beam_mass = ame->GetMass(argparser.beamZ, argparser.beamA);
     double target_mass = ame->GetMass(argparser.targetZ, argparser.targetA);
@@ -105,6 +234,7 @@ void analyze_table21(TChain *&chain, PtRapidity *&hist, const ArgumentParser &ar
     double rapidity_beam = Physics::GetBeamRapidity(beam_mass, target_mass, argparser.beam_energy, argparser.beamA);
     int nevents = chain->GetEntries();
     double norm = 0.;
+    EventKinematics kinematics(EventKinematics::CMS, EventKinematics::All, betacms, rapidity_beam);
 
     ProgressBar bar(nevents, argparser.reaction);
     for (int ievt = 0; ievt < nevents; ievt++)
@@ -120,18 +250,29 @@ void analyze_table21(TChain *&chain, PtRapidity *&hist, const ArgumentParser &ar
             continue;
         }
 
+        kinematics.Fill(amd.multi, amd.N.data(), amd.Z.data(), amd.px.data(), amd.py.data(), amd.pz.data(), *ame);
         for (int i = 0; i < amd.multi; i++)
         {
-            double mass = ame->GetMass(amd.Z[i], amd.Z[i] + amd.N[i]);
-            Particle particle(amd.N[i], amd.Z[i], amd.px[i], amd.py[i], amd.pz[i], mass);
-            particle.Initialize(betacms, rapidity_beam);
-            hist->Fill(particle, 1.);
+            Particle particle(kinematics, i);
+            hist->Fill(particle, AcceptanceWeight(particle));
         }
         bar.Update();
     }
     hist->Normalize(norm);
 }
 
+/**
+ * @brief Efficiency of the particle in the acceptance table, 1 without one.
+ */
+double AcceptanceWeight(const Particle &particle)
+{
+    if (acceptance == nullptr)
+    {
+        return 1.;
+    }
+    return acceptance->GetEfficiency(acceptance_detector, particle.species, particle.theta_lab * TMath::RadToDeg(), particle.phi * TMath::RadToDeg(), particle.kinergy_lab / particle.A);
+}
+
 void Replace_Errorbars(PtRapidity *&hist, PtRapidity *&hist_one_decay)
 {
     for (auto &[pn, h2] : hist->Histogram2D_Collection)
@@ -27,68 +27,555 @@ int get_number_nucleons(const std::string reaction)
     return amass;
 }
 
-void CompileTable21(TTree *&tree, const std::string &path, const int &amass);
-void CompileTable3(TTree *&tree, const std::string &path, const int &amass);
-void CompileTable21t(TTree *&tree, const std::string &path_table21, const std::string &path_amdgid, const std::string &path_coll_hist, const int &amass);
+template <typename Mode>
+void CompileTable(EventWriter *&writer, const std::string &path, const int &amass);
+void CompileTable21Stream(EventWriter *&writer, const std::string &path, const int &amass);
+void CompileTable3Stream(EventWriter *&writer, const std::string &path, const int &amass);
+void CompileTable21t(EventWriter *&writer, const std::string &path_table21, const std::string &path_amdgid, const std::string &path_coll_hist, const int &amass);
+void CompileTable21tStream(EventWriter *&writer, const std::string &path_table21, const std::string &path_amdgid, const std::string &path_coll_hist, const int &amass);
+
+template <typename Mode>
+void CompileTableParallel(EventWriter *&writer, const std::string &path, const int &amass, const int &nthreads);
+
+void CheckJob(ConversionJob &job);
+long Convert(ConversionJob &job, const int &amass, const int &nthreads, const bool &use_stream_reader, const OutputProfile &profile, const bool &append = false);
+std::vector<ConversionJob> ReadManifest(const std::string &path);
+bool RunBatch(std::vector<ConversionJob> jobs, const int &nthreads, const bool &use_stream_reader, const OutputProfile &profile, const bool &append);
+void BenchmarkProfiles(const ConversionJob &job, const int &amass, const int &nthreads, const bool &use_stream_reader);
 
 int main(int argc, char **argv)
 {
-    std::string reaction = argv[1];
-    std::string mode = argv[2];
+    ArgumentParser argparser(argc, argv);
+    OutputProfile profile = OutputProfile::Get(argparser.profile, argparser.float_momenta);
 
-    // check arguments validity
-    if (mode != "21" && mode != "3" && mode != "21t")
+    if (!argparser.path_manifest.empty())
     {
-        std::cout << "input mode = " << mode << std::endl;
-        throw std::invalid_argument("acceptable modes : 21, 21t or 3");
+        std::vector<ConversionJob> jobs = ReadManifest(argparser.path_manifest);
+        bool success = RunBatch(jobs, argparser.nthreads, argparser.use_stream_reader, profile, argparser.append);
+        return success ? 0 : 1;
     }
 
-    std::string path_data = argv[3];
-    std::string path_out = argv[4];
-    std::string path_coll_hist = "";
-    std::string path_amdgid = "";
+    ConversionJob job = argparser.job;
+    CheckJob(job);
 
-    _check_path(path_data);
-    if (mode == "21t")
+    if (argparser.nthreads > 1)
     {
-        path_amdgid = argv[5];
-        path_coll_hist = argv[6];
-        _check_path(path_amdgid);
-        _check_path(path_coll_hist);
+        // compress baskets in parallel while the tree is filled
+        ROOT::EnableImplicitMT(argparser.nthreads);
     }
 
-    TTree *tree = new TTree("AMD", "AMD");
-    Initialize_Tree(tree, mode);
-
     // find the total number of nucleons in the reaction system
     // e.g. Ca48Ni64E140 -> 48 + 64 = 112
-    int amass = get_number_nucleons(reaction);
+    int amass = get_number_nucleons(job.reaction);
+
+    if (argparser.benchmark)
+    {
+        BenchmarkProfiles(job, amass, argparser.nthreads, argparser.use_stream_reader);
+        return 0;
+    }
+
+    std::cout << Form("extracting table%s to %s", job.mode.c_str(), job.path_out.c_str()) << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    long nevents = Convert(job, amass, argparser.nthreads, argparser.use_stream_reader, profile, argparser.append);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // throughput of the conversion, run once with -s to compare against the stream reader
+    double input_MB = job.input_bytes / (1024. * 1024.);
+    std::cout << Form("converted %ld events, %.1f MB in %.2f s : %.1f MB/s", nevents, input_MB, elapsed.count(), input_MB / elapsed.count()) << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Check the mode and the input paths of a job and fill in its input size.
+ */
+void CheckJob(ConversionJob &job)
+{
+    if (job.mode != "21" && job.mode != "3" && job.mode != "21t")
+    {
+        std::cout << "input mode = " << job.mode << std::endl;
+        throw std::invalid_argument("acceptable modes : 21, 21t or 3");
+    }
+
+    _check_path(job.path_data);
+    job.input_bytes = fs::file_size(job.path_data);
+    if (job.mode == "21t")
+    {
+        _check_path(job.path_amdgid);
+        _check_path(job.path_coll_hist);
+        job.input_bytes += fs::file_size(job.path_amdgid) + fs::file_size(job.path_coll_hist);
+    }
+}
+
+/**
+ * @brief Convert the tables of one job into its output file. Returns the number of events written.
+ *
+ * With append, only the input after the checkpoint of the output is parsed, and job.input_bytes is set to the size of that tail.
+ */
+long Convert(ConversionJob &job, const int &amass, const int &nthreads, const bool &use_stream_reader, const OutputProfile &profile, const bool &append)
+{
+    if (append && (use_stream_reader || job.mode == "21t"))
+    {
+        throw std::invalid_argument("append mode requires mode 21 or 3 with the memory-mapped reader");
+    }
+    EventWriter *writer = new EventWriter(job.path_out, job.mode, profile, append);
+    long first_event = 0;
+    try
+    {
+        first_event = writer->GetEntries();
+        long first_offset = writer->offset;
+        if (first_offset > 0)
+        {
+            // a regenerated table is not continued from the checkpoint of another one
+            MappedFile input(job.path_data);
+            if (first_offset > (long)input.Size() || GetTableHash(input, first_offset) != writer->hash)
+            {
+                std::string msg = Form("%s is not the table %s was converted from up to byte %ld, convert it again without -a", job.path_data.c_str(), job.path_out.c_str(), first_offset);
+                throw std::invalid_argument(msg.c_str());
+            }
+            std::cout << Form("resuming %s at byte %ld after %ld events", job.path_out.c_str(), first_offset, first_event) << std::endl;
+        }
+
+        if (nthreads > 1 && !use_stream_reader && job.mode == "21")
+        {
+            CompileTableParallel<TableMode::Table21>(writer, job.path_data, amass, nthreads);
+        }
+        else if (nthreads > 1 && !use_stream_reader && job.mode == "3")
+        {
+            CompileTableParallel<TableMode::Table3>(writer, job.path_data, amass, nthreads);
+        }
+        else if (job.mode == "21")
+        {
+            if (use_stream_reader)
+                CompileTable21Stream(writer, job.path_data, amass);
+            else
+                CompileTable<TableMode::Table21>(writer, job.path_data, amass);
+        }
+        else if (job.mode == "21t")
+        {
+            if (use_stream_reader)
+                CompileTable21tStream(writer, job.path_data, job.path_amdgid, job.path_coll_hist, amass);
+            else
+                CompileTable21t(writer, job.path_data, job.path_amdgid, job.path_coll_hist, amass);
+        }
+        else if (job.mode == "3")
+        {
+            if (use_stream_reader)
+                CompileTable3Stream(writer, job.path_data, amass);
+            else
+                CompileTable<TableMode::Table3>(writer, job.path_data, amass);
+        }
+
+        if (use_stream_reader || job.mode == "21t")
+        {
+            // only the memory-mapped table21 / table3 readers keep track of the consumed bytes
+            writer->offset = -1;
+        }
+        else
+        {
+            job.input_bytes = writer->offset - first_offset;
+            writer->hash = GetTableHash(MappedFile(job.path_data), writer->offset);
+        }
+    }
+    catch (...)
+    {
+        // close the output so that it stays a valid file with the events before the error; no checkpoint is written,
+        // the consumed bytes are unknown, so -a refuses to resume it
+        writer->offset = -1;
+        try
+        {
+            writer->Close();
+        }
+        catch (...)
+        {
+        }
+        delete writer;
+        throw;
+    }
+
+    long nevents = writer->GetEntries() - first_event;
+    writer->Close();
+    delete writer;
+    return nevents;
+}
+
+/**
+ * @brief Read a batch manifest, one job per line : reaction mode path_input path_output [path_amdgid path_coll_hist]
+ *
+ * Empty lines and lines starting with `#` are skipped.
+ */
+std::vector<ConversionJob> ReadManifest(const std::string &path)
+{
+    _check_path(path);
+    std::ifstream stream(path.c_str());
+    std::vector<ConversionJob> jobs;
+
+    std::string line;
+    int iline = 0;
+    while (std::getline(stream, line))
+    {
+        iline++;
+        std::istringstream iss(line);
+        ConversionJob job;
+        if (!(iss >> job.reaction) || job.reaction[0] == '#')
+        {
+            continue;
+        }
+        if (!(iss >> job.mode >> job.path_data >> job.path_out) || (job.mode == "21t" && !(iss >> job.path_amdgid >> job.path_coll_hist)))
+        {
+            std::string msg = Form("%s:%d : expect reaction mode path_input path_output [path_amdgid path_coll_hist]", path.c_str(), iline);
+            throw std::invalid_argument(msg.c_str());
+        }
+        CheckJob(job);
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+/**
+ * @brief Run the jobs of a manifest on a pool of nthreads threads.
+ *
+ * Jobs are started largest input first, so that the long conversions do not end up last. Threads left over when there are
+ * fewer jobs parse the table21 / table3 jobs in chunks. Returns false if any job failed; the other jobs still run.
+ */
+bool RunBatch(std::vector<ConversionJob> jobs, const int &nthreads, const bool &use_stream_reader, const OutputProfile &profile, const bool &append)
+{
+    std::sort(jobs.begin(), jobs.end(), [](const ConversionJob &a, const ConversionJob &b)
+              { return a.input_bytes > b.input_bytes; });
+
+    // the reaction metadata is shared by all jobs of the same system
+    std::map<std::string, int> amass;
+    for (const auto &job : jobs)
+    {
+        if (amass.count(job.reaction) == 0)
+        {
+            amass[job.reaction] = get_number_nucleons(job.reaction);
+        }
+    }
+
+    int nworkers = std::min<int>(nthreads, jobs.size());
+    int nthreads_per_job = std::max(1, nthreads / std::max(1, nworkers));
+    if (nworkers > 1)
+    {
+        ROOT::EnableThreadSafety();
+    }
+    std::cout << Form("running %zu jobs on %d threads", jobs.size(), nworkers) << std::endl;
+
+    std::mutex mutex;
+    std::size_t next_job = 0;
+    int nfinished = 0;
+    bool success = true;
+    double total_MB = 0.;
+    auto start = std::chrono::steady_clock::now();
+
+    auto work = [&]()
+    {
+        while (true)
+        {
+            std::size_t ijob;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (next_job >= jobs.size())
+                {
+                    return;
+                }
+                ijob = next_job++;
+            }
+
+            ConversionJob &job = jobs[ijob];
+            auto job_start = std::chrono::steady_clock::now();
+            std::string report;
+            bool failed = false;
+            try
+            {
+                long nevents = Convert(job, amass.at(job.reaction), nthreads_per_job, use_stream_reader, profile, append);
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - job_start;
+                double input_MB = job.input_bytes / (1024. * 1024.);
+                report = Form("%s %s -> %s : %ld events, %.1f MB in %.2f s : %.1f MB/s", job.reaction.c_str(), job.mode.c_str(), job.path_out.c_str(), nevents, input_MB, elapsed.count(), input_MB / elapsed.count());
+            }
+            catch (const std::exception &e)
+            {
+                report = Form("%s %s -> %s : failed, %s", job.reaction.c_str(), job.mode.c_str(), job.path_out.c_str(), e.what());
+                failed = true;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            nfinished++;
+            if (failed)
+            {
+                success = false;
+            }
+            else
+            {
+                total_MB += job.input_bytes / (1024. * 1024.);
+            }
+            std::cout << Form("[%d/%zu] ", nfinished, jobs.size()) << report << std::endl;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < nworkers; i++)
+    {
+        workers.emplace_back(work);
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << Form("converted %.1f MB in %.2f s : %.1f MB/s", total_MB, elapsed.count(), total_MB / elapsed.count()) << std::endl;
+    return success;
+}
+
+/**
+ * @brief Convert the job with every output profile, with and without float32 momenta, and print write time, read time and file size.
+ *
+ * The outputs are kept as path_output.{profile}.root and path_output.{profile}-f32.root. The read time is a full scan of all branches.
+ */
+void BenchmarkProfiles(const ConversionJob &job, const int &amass, const int &nthreads, const bool &use_stream_reader)
+{
+    if (Columnar::IsColumnarFile(job.path_out))
+    {
+        throw std::invalid_argument("output profiles apply to ROOT files, not to .amdc");
+    }
+
+    std::string stem = (fs::path(job.path_out).parent_path() / fs::path(job.path_out).stem()).string();
+    std::vector<std::string> rows;
+    for (const auto &name : OutputProfile::GetNames())
+    {
+        for (const bool &float_momenta : {false, true})
+        {
+            OutputProfile profile = OutputProfile::Get(name, float_momenta);
+            ConversionJob benchmark_job = job;
+            benchmark_job.path_out = stem + "." + name + (float_momenta ? "-f32" : "") + ".root";
+
+            auto start = std::chrono::steady_clock::now();
+            long nevents = Convert(benchmark_job, amass, nthreads, use_stream_reader, profile);
+            std::chrono::duration<double> write_time = std::chrono::steady_clock::now() - start;
+
+            start = std::chrono::steady_clock::now();
+            TFile *file = new TFile(benchmark_job.path_out.c_str(), "READ");
+            TTree *tree = (TTree *)file->Get("AMD");
+            for (long ievt = 0; ievt < tree->GetEntries(); ievt++)
+            {
+                tree->GetEntry(ievt);
+            }
+            file->Close();
+            delete file;
+            std::chrono::duration<double> read_time = std::chrono::steady_clock::now() - start;
+
+            double size_MB = fs::file_size(benchmark_job.path_out) / (1024. * 1024.);
+            rows.push_back(Form("%-16s %-8s %10ld %10.2f %10.2f %10.1f", name.c_str(), float_momenta ? "float" : "double", nevents, write_time.count(), read_time.count(), size_MB));
+        }
+    }
+
+    std::cout << Form("%-16s %-8s %10s %10s %10s %10s", "profile", "momenta", "events", "write [s]", "read [s]", "size [MB]") << std::endl;
+    for (const auto &row : rows)
+    {
+        std::cout << row << std::endl;
+    }
+}
+
+template <typename Mode>
+void CompileTable(EventWriter *&writer, const std::string &path, const int &amass)
+{
+    AMD &amd = writer->event;
+    MappedFile file(path);
+    file.AdviseSequential();
+    auto [begin, end] = GetTableRange(file, writer->offset, Mode::has_header);
+    Tokenizer tokens(begin, end);
+    const char *consumed = begin;
+    bool complete = ParseEvents<Mode>(tokens, amd, amass, [&writer, &tokens, &consumed]()
+                                      { writer->Fill(); consumed = tokens.Position(); }, file.Begin());
+    // nothing follows a `0 0` record
+    writer->offset = complete ? consumed - file.Begin() : file.Size();
+    return;
+}
+
+/**
+ * @brief Start of the first line at or after pos whose event ID differs from the line before it.
+ *
+ * Particles of one event, and the decays of one primary event in table3, share an event ID, so the position does not depend
+ * on the running nucleon count. Returns end if there is none.
+ */
+const char *FindEventBoundary(const char *pos, const char *end, const int &column_eventID)
+{
+    auto next_line = [&end](const char *line) -> const char *
+    {
+        const char *eol = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        return (eol == nullptr) ? end : eol + 1;
+    };
+    auto read_eventID = [&end, &column_eventID](const char *line, int &eventID) -> bool
+    {
+        Tokenizer tokens(line, end);
+        double value;
+        for (int col = 0; col < column_eventID; col++)
+        {
+            if (!tokens.Read(value))
+            {
+                return false;
+            }
+        }
+        return tokens.Read(eventID);
+    };
+
+    // align to the start of a line
+    if (*(pos - 1) != '\n')
+    {
+        pos = next_line(pos);
+    }
 
-    if (mode == "21")
+    int first_eventID, eventID;
+    if (pos == end || !read_eventID(pos, first_eventID))
     {
-        std::cout << "extracting table21 to root file" << std::endl;
-        CompileTable21(tree, path_data, amass);
+        return pos;
     }
-    else if (mode == "21t")
+    for (pos = next_line(pos); pos != end; pos = next_line(pos))
+    {
+        if (!read_eventID(pos, eventID) || eventID != first_eventID)
+        {
+            return pos;
+        }
+    }
+    return end;
+}
+
+/**
+ * @brief Convert table21 / table3 with nthreads workers.
+ *
+ * The file is cut into byte ranges at event boundaries (see FindEventBoundary) that the workers parse independently; the
+ * calling thread fills the output chunk by chunk in event order. At most 2 * nthreads chunks are held in memory.
+ */
+template <typename Mode>
+void CompileTableParallel(EventWriter *&writer, const std::string &path, const int &amass, const int &nthreads)
+{
+    AMD &amd = writer->event;
+    MappedFile file(path);
+    file.AdviseSequential();
+
+    auto [begin, end] = GetTableRange(file, writer->offset, Mode::has_header);
+
+    // chunks of 1 - 8 MB, a few per thread so that the load stays balanced
+    std::size_t chunk_size = (end - begin) / (8 * nthreads);
+    chunk_size = std::clamp<std::size_t>(chunk_size, 1 << 20, 8 << 20);
+
+    struct Chunk
+    {
+        const char *begin, *end;
+        EventBuffer<Mode> events;
+        const char *consumed = nullptr; // end of the last complete event
+        bool ready = false;
+        bool terminated = false;
+        std::exception_ptr error; // a parse error after the events of the chunk
+    };
+    std::vector<Chunk> chunks;
+    const char *chunk_begin = begin;
+    while (chunk_begin != end)
     {
-        std::cout << "extracting table21, with xyzt to root file" << std::endl;
-        CompileTable21t(tree, path_data, path_amdgid, path_coll_hist, amass);
+        const char *chunk_end = (std::size_t)(end - chunk_begin) > chunk_size ? FindEventBoundary(chunk_begin + chunk_size, end, Mode::column_eventID) : end;
+        chunks.push_back({chunk_begin, chunk_end, EventBuffer<Mode>(), chunk_begin});
+        chunk_begin = chunk_end;
     }
-    else if (mode == "3")
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t next_chunk = 0;
+    std::size_t written = 0;
+    const std::size_t window = 2 * nthreads;
+
+    auto work = [&]()
+    {
+        AMD event;
+        while (true)
+        {
+            std::size_t ichunk;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&]()
+                        { return next_chunk >= chunks.size() || next_chunk < written + window; });
+                if (next_chunk >= chunks.size())
+                {
+                    return;
+                }
+                ichunk = next_chunk++;
+            }
+
+            Chunk &chunk = chunks[ichunk];
+            Tokenizer tokens(chunk.begin, chunk.end);
+            bool complete = true;
+            std::exception_ptr error;
+            try
+            {
+                complete = ParseEvents<Mode>(tokens, event, amass, [&chunk, &event, &tokens]()
+                                             { chunk.events.Push(event); chunk.consumed = tokens.Position(); }, file.Begin());
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            chunk.error = error;
+            chunk.terminated = !complete;
+            chunk.ready = true;
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < nthreads; i++)
     {
-        std::cout << "extracting table3 to root file" << std::endl;
-        CompileTable3(tree, path_data, amass);
+        workers.emplace_back(work);
     }
 
-    TFile *outputfile = new TFile(path_out.c_str(), "RECREATE");
-    outputfile->cd();
-    tree->Write();
-    outputfile->Write();
-    outputfile->Close();
+    // the parse error of the first chunk that has one, after the events before it are written
+    std::exception_ptr error;
+    for (std::size_t ichunk = 0; ichunk < chunks.size(); ichunk++)
+    {
+        Chunk &chunk = chunks[ichunk];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&chunk]()
+                    { return chunk.ready; });
+        }
+
+        for (std::size_t ievt = 0; ievt < chunk.events.Size(); ievt++)
+        {
+            chunk.events.Load(ievt, amd);
+            writer->Fill();
+        }
+        chunk.events = EventBuffer<Mode>();
+        writer->offset = chunk.terminated ? file.Size() : chunk.consumed - file.Begin();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        written = ichunk + 1;
+        if (chunk.terminated || chunk.error)
+        {
+            // a `0 0` record ends the table, as in the sequential reader; after a parse error nothing more is read
+            next_chunk = chunks.size();
+        }
+        cv.notify_all();
+        if (chunk.terminated || chunk.error)
+        {
+            error = chunk.error;
+            break;
+        }
+    }
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+    return;
 }
 
-void CompileTable21(TTree *&tree, const std::string &path, const int &amass)
+void CompileTable21Stream(EventWriter *&writer, const std::string &path, const int &amass)
 {
+    AMD &amd = writer->event;
     std::ifstream file_table21(path.c_str());
 
     int eventID;
@@ -110,7 +597,7 @@ void CompileTable21(TTree *&tree, const std::string &path, const int &amass)
         if (nucleons_count == amass)
         {
             amd.multi = multi;
-            tree->Fill();
+            writer->Fill();
             multi = 0;
             nucleons_count = 0;
         }
@@ -118,8 +605,131 @@ void CompileTable21(TTree *&tree, const std::string &path, const int &amass)
     return;
 }
 
-void CompileTable21t(TTree *&tree, const std::string &path_table21, const std::string &path_amdgid, const std::string &path_coll_hist, const int &amass)
+/**
+ * @brief Join table21 with the last interaction of its nucleons, taken from amdgid.dat and hist_coll.dat.
+ *
+ * For every primary fragment, t is the latest and (x, y, z) the average position of the last collision of each nucleon
+ * with a nucleon outside the fragment.
+ * The three files are merged in one forward pass per event: the gid table, then the collisions reduced into the last
+ * interaction of each gid, then the fragments of table21. Memory is O(amass) whatever the number of collisions.
+ */
+void CompileTable21t(EventWriter *&writer, const std::string &path_table21, const std::string &path_amdgid, const std::string &path_coll_hist, const int &amass)
 {
+    AMD &amd = writer->event;
+    MappedFile file_table21(path_table21);
+    MappedFile file_amdgid(path_amdgid);
+    file_table21.AdviseSequential();
+    file_amdgid.AdviseSequential();
+
+    Tokenizer table21(file_table21.Begin(), file_table21.End());
+    Tokenizer amdgid(file_amdgid.Begin(), file_amdgid.End());
+    amdgid.SkipLine();
+    CollisionStream collisions(path_coll_hist);
+
+    // gid -> index of the primary fragment, -1 if the nucleon is not in the current event
+    std::vector<int> fragment_of_gid;
+    // (fragment, gid) of every nucleon, in the order of amdgid.dat
+    std::vector<std::array<int, 2>> nucleons(amass);
+    // gid -> last collision with a nucleon from another fragment
+    std::vector<std::array<double, 7>> last_interaction;
+    std::vector<int> fragment_size(AMD::MAX_MULTI);
+
+    int prim_pid, nuc, gid, N, Z, ievt, eventID;
+    while (true)
+    {
+        int nfragments = 0;
+        int nread = 0;
+        for (; nread < amass; nread++)
+        {
+            const char *row = amdgid.Position();
+            if (!(amdgid.Read(prim_pid) && amdgid.Read(nuc) && amdgid.Read(gid) && amdgid.Read(N) && amdgid.Read(Z) && amdgid.Read(ievt)))
+            {
+                break;
+            }
+            if (prim_pid < 1 || prim_pid > AMD::MAX_MULTI || gid < 0)
+            {
+                ThrowParseError(row, file_amdgid.Begin(), Form("%s : prim_pid %d (1 to %d) or gid %d (>= 0) out of range", path_amdgid.c_str(), prim_pid, AMD::MAX_MULTI, gid));
+            }
+            if (gid >= (int)fragment_of_gid.size())
+            {
+                fragment_of_gid.resize(gid + 1, -1);
+                last_interaction.resize(gid + 1);
+            }
+            fragment_of_gid[gid] = prim_pid - 1;
+            last_interaction[gid] = {0., 0., 0., 0., 0., 0., 0.};
+            nucleons[nread] = {prim_pid - 1, gid};
+            nfragments = std::max(nfragments, prim_pid);
+        }
+        file_amdgid.ReadAhead(amdgid.Position());
+        if (nread < amass)
+        {
+            break;
+        }
+
+        // records of earlier events have no gid table and are skipped
+        // ties in time are resolved in favour of the later record, as in the file order
+        for (; collisions.Good() && collisions.Peek().ievt <= ievt; collisions.Pop())
+        {
+            const Collision &collision = collisions.Peek();
+            if (collision.ievt != ievt || collision.gid < 0 || collision.gid >= (int)fragment_of_gid.size() || fragment_of_gid[collision.gid] == -1)
+            {
+                continue;
+            }
+            int fragment = fragment_of_gid[collision.gid];
+            int partner_fragment = (collision.collid >= 0 && collision.collid < (int)fragment_of_gid.size()) ? fragment_of_gid[collision.collid] : -1;
+            if (partner_fragment != fragment && collision.record[0] >= last_interaction[collision.gid][0])
+            {
+                last_interaction[collision.gid] = collision.record;
+            }
+        }
+
+        for (int j = 0; j < nfragments; j++)
+        {
+            amd.t[j] = -1.;
+            amd.x[j] = amd.y[j] = amd.z[j] = 0.;
+            fragment_size[j] = 0;
+        }
+        for (const auto &[fragment, gid] : nucleons)
+        {
+            const auto &last = last_interaction[gid];
+            amd.t[fragment] = std::max(amd.t[fragment], last[0]);
+            amd.x[fragment] += last[1];
+            amd.y[fragment] += last[2];
+            amd.z[fragment] += last[3];
+            fragment_size[fragment]++;
+            fragment_of_gid[gid] = -1;
+        }
+
+        TableMode::Row row = TableMode::Particle;
+        for (int j = 0; j < nfragments && row == TableMode::Particle; j++)
+        {
+            // a prim_pid without nucleons in amdgid.dat keeps t = -1 and (0, 0, 0)
+            if (fragment_size[j] > 0)
+            {
+                amd.x[j] /= fragment_size[j];
+                amd.y[j] /= fragment_size[j];
+                amd.z[j] /= fragment_size[j];
+            }
+            row = TableMode::Table21t::ReadRow(table21, amd, j, eventID);
+        }
+        file_table21.ReadAhead(table21.Position());
+        if (row == TableMode::Invalid)
+        {
+            ThrowParseError(table21.Position(), file_table21.Begin(), "not a number or out of range");
+        }
+        if (row != TableMode::Particle)
+        {
+            break;
+        }
+        amd.multi = nfragments;
+        writer->Fill();
+    }
+    return;
+}
+
+void CompileTable21tStream(EventWriter *&writer, const std::string &path_table21, const std::string &path_amdgid, const std::string &path_coll_hist, const int &amass)
+{
+    AMD &amd = writer->event;
     int event_processed = 0;
     std::ifstream file_table21(path_table21.c_str());
 
@@ -163,6 +773,11 @@ void CompileTable21t(TTree *&tree, const std::string &path_table21, const std::s
                 file_coll_hist >> rp[r];
             }
             std::pair<int, std::vector<double>> pair = std::make_pair(collid, rp);
+            if (!file_coll_hist)
+            {
+                // end of the collision history, the last event is still to be filled
+                ievt = current_evt + 1;
+            }
             if (ievt == current_evt)
             {
                 if (coll_hist.count(gid) == 0)
@@ -174,7 +789,6 @@ void CompileTable21t(TTree *&tree, const std::string &path_table21, const std::s
             }
             else
             {
-                double px, py, pz, bimp, buffer;
                 // for each particle in the current event
                 for (unsigned int j = 1; j <= gidmap.size(); j++)
                 {
@@ -206,20 +820,17 @@ void CompileTable21t(TTree *&tree, const std::string &path_table21, const std::s
                     spacetime[2] /= gidmap[j].size();
                     spacetime[3] /= gidmap[j].size();
 
-                    amd.t[j] = spacetime[0];
-                    amd.x[j] = spacetime[1];
-                    amd.y[j] = spacetime[2];
-                    amd.z[j] = spacetime[3];
+                    amd.t[j - 1] = spacetime[0];
+                    amd.x[j - 1] = spacetime[1];
+                    amd.y[j - 1] = spacetime[2];
+                    amd.z[j - 1] = spacetime[3];
 
-                    file_table21 >> amd.Z[j] >> amd.N[j] >> amd.px[j] >> amd.py[j] >> amd.pz[j];
-                    for (auto _ = 0; _ < 5; _++)
-                    {
-                        file_table21 >> buffer;
-                    }
+                    file_table21 >> amd.Z[j - 1] >> amd.N[j - 1] >> amd.px[j - 1] >> amd.py[j - 1] >> amd.pz[j - 1];
+                    file_table21 >> amd.ENG[j - 1] >> amd.LANG[j - 1] >> amd.JX[j - 1] >> amd.JY[j - 1] >> amd.JZ[j - 1];
                     file_table21 >> amd.b >> ievt;
                 }
                 amd.multi = gidmap.size();
-                tree->Fill();
+                writer->Fill();
                 gidmap.clear();
                 coll_hist.clear();
                 coll_hist[gid].push_back(pair);
@@ -230,8 +841,9 @@ void CompileTable21t(TTree *&tree, const std::string &path_table21, const std::s
     }
 }
 
-void CompileTable3(TTree *&tree, const std::string &path, const int &amass)
+void CompileTable3Stream(EventWriter *&writer, const std::string &path, const int &amass)
 {
+    AMD &amd = writer->event;
     std::ifstream file_table3(path.c_str());
     file_table3.ignore(99, '\n');
 
@@ -255,7 +867,7 @@ void CompileTable3(TTree *&tree, const std::string &path, const int &amass)
         if (nucleons_count == amass)
         {
             amd.multi = multi;
-            tree->Fill();
+            writer->Fill();
             nucleons_count = 0;
             multi = 0;
         }
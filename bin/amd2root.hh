@@ -5,81 +5,248 @@
 #include <string>
 #include <map>
 #include <regex>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+#include <sstream>
+#include <cstring>
+#include <getopt.h>
 #include <filesystem>
 namespace fs = std::filesystem;
 
 #include "TFile.h"
 #include "TTree.h"
 #include "TMath.h"
+#include "TROOT.h"
 
-struct AMD
+#include "MappedFile.hh"
+#include "Tokenizer.hh"
+#include "AMDTable.hh"
+#include "EventWriter.hh"
+
+// one conversion : the positional arguments of amd2root, or one line of a batch manifest
+struct ConversionJob
 {
-    const static int MAX_MULTI = 128;
-    // base
-    int multi;
-    double b;
-    std::array<int, MAX_MULTI> N;
-    std::array<int, MAX_MULTI> Z;
-    std::array<double, MAX_MULTI> px;
-    std::array<double, MAX_MULTI> py;
-    std::array<double, MAX_MULTI> pz;
-
-    // table21
-    std::array<double, MAX_MULTI> ENG;
-    std::array<double, MAX_MULTI> LANG;
-    std::array<double, MAX_MULTI> JX;
-    std::array<double, MAX_MULTI> JY;
-    std::array<double, MAX_MULTI> JZ;
-
-    // table3
-    std::array<double, MAX_MULTI> J;
-    std::array<double, MAX_MULTI> M;
-    std::array<double, MAX_MULTI> WEIGHT;
-    std::array<int, MAX_MULTI> iFRG;
-
-    // table21t
-    std::array<double, MAX_MULTI> t;
-    std::array<double, MAX_MULTI> x;
-    std::array<double, MAX_MULTI> y;
-    std::array<double, MAX_MULTI> z;
+    std::string reaction;
+    std::string mode;
+    std::string path_data;
+    std::string path_out;
+    std::string path_amdgid;
+    std::string path_coll_hist;
+
+    // total size of the input tables, filled by CheckJob()
+    double input_bytes = 0.;
 };
 
-AMD amd;
+class ArgumentParser
+{
+public:
+    // positional arguments
+    ConversionJob job;
+
+    // manifest of jobs for batch mode, replaces the positional arguments
+    std::string path_manifest;
+
+    // read tables through std::ifstream instead of the memory-mapped tokenizer, for comparison
+    bool use_stream_reader;
+
+    // number of parsing threads for table21 / table3, or of concurrent jobs in batch mode
+    int nthreads;
+
+    // compression and basket settings of the output tree, see OutputProfile.hh
+    std::string profile;
+    bool float_momenta;
+
+    // convert once per profile and report write time, read time and file size
+    bool benchmark;
+
+    // append the events after the checkpoint of an existing output, see EventWriter
+    bool append;
+
+    ArgumentParser(int argc, char *argv[])
+    {
+        use_stream_reader = false;
+        nthreads = 1;
+        profile = "default";
+        float_momenta = false;
+        benchmark = false;
+        append = false;
+
+        options = {
+            {"help", no_argument, 0, 'h'},
+            {"stream", no_argument, 0, 's'},
+            {"threads", required_argument, 0, 'j'},
+            {"batch", required_argument, 0, 'b'},
+            {"profile", required_argument, 0, 'p'},
+            {"float-momenta", no_argument, 0, 'f'},
+            {"benchmark", no_argument, 0, 'B'},
+            {"append", no_argument, 0, 'a'},
+            {0, 0, 0, 0},
+        };
+
+        int option_index = 0;
+        int opt;
+        while ((opt = getopt_long(argc, argv, "hsj:b:p:fBa", options.data(), &option_index)) != -1)
+        {
+            switch (opt)
+            {
+            case 's':
+            {
+                this->use_stream_reader = true;
+                break;
+            }
+            case 'j':
+            {
+                this->nthreads = std::max(1, std::stoi(optarg));
+                break;
+            }
+            case 'b':
+            {
+                this->path_manifest = optarg;
+                break;
+            }
+            case 'p':
+            {
+                this->profile = optarg;
+                break;
+            }
+            case 'f':
+            {
+                this->float_momenta = true;
+                break;
+            }
+            case 'B':
+            {
+                this->benchmark = true;
+                break;
+            }
+            case 'a':
+            {
+                this->append = true;
+                break;
+            }
+            case 'h':
+            {
+                this->help();
+                std::exit(1);
+            }
+            default:
+            {
+                std::cout << "Got unknown option." << std::endl;
+                this->help();
+                std::exit(1);
+            }
+            }
+        }
+
+        if (!this->path_manifest.empty())
+        {
+            return;
+        }
 
-void Initialize_Tree(TTree *&tree, const std::string &mode)
+        std::vector<std::string> positional(argv + optind, argv + argc);
+        if (positional.size() < 4)
+        {
+            this->help();
+            std::exit(1);
+        }
+        this->job.reaction = positional[0];
+        this->job.mode = positional[1];
+        this->job.path_data = positional[2];
+        this->job.path_out = positional[3];
+
+        if (this->job.mode == "21t")
+        {
+            if (positional.size() < 6)
+            {
+                std::cout << "mode 21t requires amdgid.dat and hist_coll.dat." << std::endl;
+                this->help();
+                std::exit(1);
+            }
+            this->job.path_amdgid = positional[4];
+            this->job.path_coll_hist = positional[5];
+        }
+    }
+
+    void help()
+    {
+        const char *msg = R"(
+            usage : amd2root.exe [options] reaction mode path_input path_output [path_amdgid path_coll_hist]
+                    amd2root.exe [options] -b manifest
+            reaction    reaction tag, e.g. Ca48Ni64E140
+            mode        21, 3 or 21t
+            -s          read tables with std::ifstream (legacy reader, for benchmarking).
+            -j          number of threads for mode 21 and 3, e.g. `-j 32`. Events keep their original order.
+                        With -b, number of jobs converted concurrently.
+            -b          batch mode, convert every job of the manifest. One job per line, same fields as the positional arguments:
+                        `reaction mode path_input path_output [path_amdgid path_coll_hist]`. Lines starting with # are skipped.
+            -p          output profile : default, fast-write, fast-read or smallest (compression, basket and cluster size).
+            -f          store px, py, pz as float32 on disk (Double32_t, still read as double).
+            -a          append mode for tables that are still being written, mode 21 and 3 only. Parse the input from the
+                        checkpoint stored in path_output and append the new events; starts from scratch if path_output does not exist.
+            -B          benchmark : convert once per profile, with and without -f, to path_output.{profile}.root and
+                        report write time, read time and file size.
+            -h          Print help message.
+        )";
+        std::cout << msg << std::endl;
+    }
+
+protected:
+    std::vector<option> options;
+};
+
+// one record of hist_coll.dat
+struct Collision
+{
+    int ievt, gid, collid;
+    std::array<double, 7> record; // t, x, y, z, px, py, pz
+};
+
+/**
+ * @brief Forward reader of hist_coll.dat with one record of lookahead.
+ *
+ * Peek() is the next unconsumed record, Pop() moves on to the one after. The file is mapped and read ahead, pages already consumed are released.
+ */
+class CollisionStream
 {
-    // Set base branches
-    tree->Branch("multi", &amd.multi, "multi/I");
-    tree->Branch("b", &amd.b, "b/D");
-    tree->Branch("N", &amd.N[0], "N[multi]/I");
-    tree->Branch("Z", &amd.Z[0], "Z[multi]/I");
-    tree->Branch("px", &amd.px[0], "px[multi]/D");
-    tree->Branch("py", &amd.py[0], "py[multi]/D");
-    tree->Branch("pz", &amd.pz[0], "pz[multi]/D");
-
-    if (mode == "21" || mode == "21t")
+public:
+    CollisionStream(const std::string &path) : file(path), tokens(file.Begin(), file.End())
     {
-        tree->Branch("ENG", &amd.ENG[0], "ENG[multi]/D");
-        tree->Branch("LANG", &amd.LANG[0], "LANG[multi]/D");
-        tree->Branch("JX", &amd.JX[0], "JX[multi]/D");
-        tree->Branch("JY", &amd.JY[0], "JY[multi]/D");
-        tree->Branch("JZ", &amd.JZ[0], "JZ[multi]/D");
+        file.AdviseSequential();
+        tokens.SkipLine();
+        this->Pop();
     }
 
-    if (mode == "3")
+    bool Good() const { return good; }
+    const Collision &Peek() const { return next; }
+    void Pop()
     {
-        tree->Branch("J", &amd.J[0], "J[multi]/D");
-        tree->Branch("M", &amd.M[0], "M[multi]/D");
-        tree->Branch("WEIGHT", &amd.WEIGHT[0], "WEIGHT[multi]/D");
-        tree->Branch("iFRG", &amd.iFRG[0], "iFRG[multi]/I");
+        good = ReadCollision(tokens, next);
+        file.ReadAhead(tokens.Position());
     }
 
-    if (mode == "21t")
+private:
+    bool ReadCollision(Tokenizer &tokens, Collision &collision)
     {
-        tree->Branch("t", &amd.t[0], "t[multi]/D");
-        tree->Branch("x", &amd.x[0], "x[multi]/D");
-        tree->Branch("y", &amd.y[0], "y[multi]/D");
-        tree->Branch("z", &amd.z[0], "z[multi]/D");
+        if (!(tokens.Read(collision.ievt) && tokens.Read(collision.gid) && tokens.Read(collision.collid)))
+        {
+            return false;
+        }
+        for (auto &value : collision.record)
+        {
+            if (!tokens.Read(value))
+            {
+                return false;
+            }
+        }
+        return true;
     }
-    return;
-}
+
+    MappedFile file;
+    Tokenizer tokens;
+    Collision next;
+    bool good;
+};
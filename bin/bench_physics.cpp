@@ -0,0 +1,250 @@
+#include "bench_physics.hh"
+
+const double BETACMS = 0.18;
+const double BEAM_RAPIDITY = 0.36;
+
+const std::vector<std::string> KERNELS = {"GetPt", "GetP", "GetEkin", "GetPhi", "GetTheta", "boostz", "GetRapidity"};
+
+Input GenerateInput(const std::size_t &n, const unsigned int &seed);
+template <typename P>
+Columns<P> GetColumns(const Input &input, AME &ame);
+template <typename P>
+void RunKernel(const int &kernel, const Columns<P> &columns, const std::size_t &first, const std::size_t &n, typename P::Real *out);
+double Time(const std::function<void(const std::size_t &, const std::size_t &)> &run, const std::size_t &n, const int &batch, const long &nparticles);
+template <typename Real>
+void Compare(const std::vector<double> &reference, const std::vector<Real> &result, double &max_abs, double &max_ulp);
+
+void BenchmarkKernels(const Input &input, AME &ame, const ArgumentParser &argparser);
+void BenchmarkEvents(const Input &input, AME &ame, const ArgumentParser &argparser);
+
+int main(int argc, char **argv)
+{
+    ArgumentParser argparser(argc, argv);
+
+    // a pool of distinct particles larger than the caches would make the benchmark time memory instead of the kernels
+    const std::size_t n = std::max<std::size_t>(argparser.batch, 4096) / argparser.batch * argparser.batch;
+    Input input = GenerateInput(n, argparser.seed);
+    AME ame;
+
+    std::cout << Form("%d particles per call, %ld per kernel and path; the deviations are from the double path, in ulp of float", argparser.batch, argparser.nparticles) << std::endl;
+    BenchmarkKernels(input, ame, argparser);
+    std::cout << std::endl;
+    BenchmarkEvents(input, ame, argparser);
+    return 0;
+}
+
+/**
+ * @brief Every kernel of Physics::Batch on the columns of each policy; Float at every level of the CPU.
+ */
+void BenchmarkKernels(const Input &input, AME &ame, const ArgumentParser &argparser)
+{
+    const std::size_t n = input.N.size();
+    Columns<Physics::Float> columns_float = GetColumns<Physics::Float>(input, ame);
+    Columns<Physics::Double> columns_double = GetColumns<Physics::Double>(input, ame);
+
+    std::cout << Form("%-12s %-14s %12s %10s %14s %14s", "kernel", "path", "ns/particle", "speed-up", "max |diff|", "max diff [ulp]") << std::endl;
+    for (int kernel = 0; kernel < static_cast<int>(KERNELS.size()); kernel++)
+    {
+        std::vector<double> reference(n);
+        RunKernel<Physics::Double>(kernel, columns_double, 0, n, reference.data());
+        double double_time = Time([&](const std::size_t &i, const std::size_t &m)
+                                  { RunKernel<Physics::Double>(kernel, columns_double, i, m, reference.data()); },
+                                  n, argparser.batch, argparser.nparticles);
+        std::cout << Form("%-12s %-14s %12.3f %10.2f %14.3g %14.1f", KERNELS[kernel].c_str(), "double", double_time * 1e9 / argparser.nparticles, 1., 0., 0.) << std::endl;
+
+        for (int level = Physics::Batch::Scalar; level <= Physics::Batch::GetSupportedLevel(); level++)
+        {
+            Physics::Batch::SetLevel(static_cast<Physics::Batch::Level>(level));
+            std::vector<float> result(n);
+            RunKernel<Physics::Float>(kernel, columns_float, 0, n, result.data());
+            double time = Time([&](const std::size_t &i, const std::size_t &m)
+                               { RunKernel<Physics::Float>(kernel, columns_float, i, m, result.data()); },
+                               n, argparser.batch, argparser.nparticles);
+
+            double max_abs = 0., max_ulp = 0.;
+            Compare(reference, result, max_abs, max_ulp);
+            std::string path = "float/" + Physics::Batch::GetLevelName(static_cast<Physics::Batch::Level>(level));
+            std::cout << Form("%-12s %-14s %12.3f %10.2f %14.3g %14.1f", KERNELS[kernel].c_str(), path.c_str(), time * 1e9 / argparser.nparticles, double_time / time, max_abs, max_ulp) << std::endl;
+        }
+    }
+    Physics::Batch::SetLevel(Physics::Batch::GetSupportedLevel());
+}
+
+/**
+ * @brief Whole events through EventKinematicsT::Fill (all columns, cms to lab) and one ParticleT at a time, in each policy.
+ */
+void BenchmarkEvents(const Input &input, AME &ame, const ArgumentParser &argparser)
+{
+    const std::size_t n = input.N.size();
+    const int batch = argparser.batch;
+    EventKinematicsT<Physics::Float> event_float(EventKinematicsT<Physics::Float>::CMS, EventKinematicsT<Physics::Float>::All, BETACMS, BEAM_RAPIDITY);
+    EventKinematicsT<Physics::Double> event_double(EventKinematicsT<Physics::Double>::CMS, EventKinematicsT<Physics::Double>::All, BETACMS, BEAM_RAPIDITY);
+
+    auto fill = [&](auto &event, const std::size_t &i, const std::size_t &m)
+    { event.Fill(m, &input.N[i], &input.Z[i], &input.px[i], &input.py[i], &input.pz[i], ame); };
+    auto initialize = [&](auto particle_type, const std::size_t &i, const std::size_t &m)
+    {
+        typedef decltype(particle_type) ParticleType;
+        for (std::size_t j = i; j < i + m; j++)
+        {
+            ParticleType particle(input.N[j], input.Z[j], input.px[j], input.py[j], input.pz[j], ame.GetMass(input.Z[j], input.N[j] + input.Z[j]));
+            particle.Initialize(BETACMS, BEAM_RAPIDITY);
+        }
+    };
+
+    std::cout << Form("%-30s %12s %10s", "event kinematics", "ns/particle", "speed-up") << std::endl;
+    double double_time = Time([&](const std::size_t &i, const std::size_t &m)
+                              { fill(event_double, i, m); },
+                              n, batch, argparser.nparticles);
+    std::cout << Form("%-30s %12.3f %10.2f", "EventKinematics<double>", double_time * 1e9 / argparser.nparticles, 1.) << std::endl;
+    for (int level = Physics::Batch::Scalar; level <= Physics::Batch::GetSupportedLevel(); level++)
+    {
+        Physics::Batch::SetLevel(static_cast<Physics::Batch::Level>(level));
+        double time = Time([&](const std::size_t &i, const std::size_t &m)
+                           { fill(event_float, i, m); },
+                           n, batch, argparser.nparticles);
+        std::string path = "EventKinematics<float>/" + Physics::Batch::GetLevelName(static_cast<Physics::Batch::Level>(level));
+        std::cout << Form("%-30s %12.3f %10.2f", path.c_str(), time * 1e9 / argparser.nparticles, double_time / time) << std::endl;
+    }
+    double particle_double_time = Time([&](const std::size_t &i, const std::size_t &m)
+                                       { initialize(ParticleT<Physics::Double>(0, 1, 0., 0., 0.), i, m); },
+                                       n, batch, argparser.nparticles);
+    double particle_float_time = Time([&](const std::size_t &i, const std::size_t &m)
+                                      { initialize(ParticleT<Physics::Float>(0, 1, 0., 0., 0.), i, m); },
+                                      n, batch, argparser.nparticles);
+    std::cout << Form("%-30s %12.3f %10.2f", "Particle<double>", particle_double_time * 1e9 / argparser.nparticles, double_time / particle_double_time) << std::endl;
+    std::cout << Form("%-30s %12.3f %10.2f", "Particle<float>", particle_float_time * 1e9 / argparser.nparticles, double_time / particle_float_time) << std::endl;
+
+    // deviation of every column of the Float events, at the level of the CPU, from the Double events
+    Physics::Batch::SetLevel(Physics::Batch::GetSupportedLevel());
+    std::vector<std::string> names = {"pmag_trans", "phi", "pmag_cms", "kinergy_cms", "theta_cms", "rapidity_cms", "pz_lab", "pmag_lab", "kinergy_lab", "theta_lab", "rapidity_lab"};
+    auto get_columns = [](auto &event)
+    { return std::vector<decltype(&event.px)>{&event.pmag_trans, &event.phi, &event.pmag_cms, &event.kinergy_cms, &event.theta_cms, &event.rapidity_cms, &event.pz_lab, &event.pmag_lab, &event.kinergy_lab, &event.theta_lab, &event.rapidity_lab}; };
+    std::vector<double> max_abs(names.size(), 0.), max_ulp(names.size(), 0.);
+    for (std::size_t i = 0; i < n; i += batch)
+    {
+        fill(event_float, i, batch);
+        fill(event_double, i, batch);
+        auto columns_float = get_columns(event_float);
+        auto columns_double = get_columns(event_double);
+        for (std::size_t k = 0; k < names.size(); k++)
+        {
+            std::vector<double> reference(columns_double[k]->begin(), columns_double[k]->begin() + batch);
+            std::vector<float> result(columns_float[k]->begin(), columns_float[k]->begin() + batch);
+            Compare(reference, result, max_abs[k], max_ulp[k]);
+        }
+    }
+    std::cout << std::endl;
+    std::cout << Form("%-14s %14s %14s", "column", "max |diff|", "max diff [ulp]") << std::endl;
+    for (std::size_t k = 0; k < names.size(); k++)
+    {
+        std::cout << Form("%-14s %14.3g %14.1f", names[k].c_str(), max_abs[k], max_ulp[k]) << std::endl;
+    }
+}
+
+Input GenerateInput(const std::size_t &n, const unsigned int &seed)
+{
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+
+    Input input;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        int Z = 1 + engine() % 4;
+        int N = engine() % (Z + 3);
+        double p = std::pow(10., 3. * uniform(engine));
+        double cos_theta = 2. * uniform(engine) - 1.;
+        double phi = 2. * TMath::Pi() * uniform(engine);
+        double sin_theta = std::sqrt(1. - cos_theta * cos_theta);
+        input.N.push_back(N);
+        input.Z.push_back(Z);
+        input.px.push_back(p * sin_theta * std::cos(phi));
+        input.py.push_back(p * sin_theta * std::sin(phi));
+        input.pz.push_back(p * cos_theta);
+    }
+    return input;
+}
+
+template <typename P>
+Columns<P> GetColumns(const Input &input, AME &ame)
+{
+    // as EventKinematicsT<P> in the cms, at the scalar level
+    Physics::Batch::Level level = Physics::Batch::GetLevel();
+    Physics::Batch::SetLevel(Physics::Batch::Scalar);
+    const std::size_t n = input.N.size();
+    Columns<P> columns;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        int A = input.N[i] + input.Z[i];
+        columns.mass.push_back(ame.GetMass(input.Z[i], A));
+        columns.px.push_back(input.px[i] * A);
+        columns.py.push_back(input.py[i] * A);
+        columns.pz.push_back(input.pz[i] * A);
+    }
+    columns.pt.resize(n);
+    columns.p.resize(n);
+    columns.ekin.resize(n);
+    Physics::Batch::GetPt<P>(n, columns.px.data(), columns.py.data(), columns.pt.data());
+    Physics::Batch::GetP<P>(n, columns.pt.data(), columns.pz.data(), columns.p.data());
+    Physics::Batch::GetEkin<P>(n, columns.mass.data(), columns.p.data(), columns.ekin.data());
+    Physics::Batch::SetLevel(level);
+    return columns;
+}
+
+template <typename P>
+void RunKernel(const int &kernel, const Columns<P> &columns, const std::size_t &i, const std::size_t &n, typename P::Real *out)
+{
+    const typename P::Real beta = BETACMS;
+    const typename P::Real gamma = Physics::GetGamma<P>(beta);
+    switch (kernel)
+    {
+    case 0:
+        return Physics::Batch::GetPt<P>(n, &columns.px[i], &columns.py[i], out + i);
+    case 1:
+        return Physics::Batch::GetP<P>(n, &columns.pt[i], &columns.pz[i], out + i);
+    case 2:
+        return Physics::Batch::GetEkin<P>(n, &columns.mass[i], &columns.p[i], out + i);
+    case 3:
+        return Physics::Batch::GetPhi<P>(n, &columns.px[i], &columns.py[i], out + i);
+    case 4:
+        return Physics::Batch::GetTheta<P>(n, &columns.pt[i], &columns.pz[i], out + i);
+    case 5:
+        return Physics::Batch::boostz<P>(n, &columns.mass[i], &columns.pz[i], &columns.ekin[i], beta, gamma, out + i);
+    default:
+        return Physics::Batch::GetRapidity<P>(n, &columns.ekin[i], &columns.pz[i], &columns.mass[i], out + i);
+    }
+}
+
+/**
+ * @brief Seconds to run nparticles, in calls of batch particles cycling through the pool of n.
+ */
+double Time(const std::function<void(const std::size_t &, const std::size_t &)> &run, const std::size_t &n, const int &batch, const long &nparticles)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::size_t first = 0;
+    for (long done = 0; done < nparticles; done += batch)
+    {
+        std::size_t m = std::min<long>(batch, nparticles - done);
+        if (first + m > n)
+        {
+            first = 0;
+        }
+        run(first, m);
+        first += m;
+    }
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    return time.count();
+}
+
+template <typename Real>
+void Compare(const std::vector<double> &reference, const std::vector<Real> &result, double &max_abs, double &max_ulp)
+{
+    for (std::size_t i = 0; i < reference.size(); i++)
+    {
+        double diff = std::fabs(reference[i] - result[i]);
+        float value = std::fabs(reference[i]);
+        double ulp = std::nextafter(value, INFINITY) - value;
+        max_abs = std::max(max_abs, diff);
+        max_ulp = std::max(max_ulp, diff / ulp);
+    }
+}
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <getopt.h>
+
+#include "TMath.h"
+#include "TString.h"
+
+#include "AME.hh"
+#include "Physics.hh"
+#include "PhysicsBatch.hh"
+#include "EventKinematics.hh"
+#include "Particle.hh"
+
+// particles as read from the AMD tables, momenta per nucleon
+struct Input
+{
+    std::vector<int> N, Z;
+    std::vector<double> px, py, pz;
+};
+
+// the inputs of the kernels in the precision of P, as the columns of EventKinematicsT<P>
+template <typename P>
+struct Columns
+{
+    std::vector<typename P::Real> mass, px, py, pz, pt, p, ekin;
+};
+
+class ArgumentParser
+{
+public:
+    // particles per call of a kernel, and per event
+    int batch;
+    // total particles per kernel and path
+    long nparticles;
+    unsigned int seed;
+
+    ArgumentParser(int argc, char *argv[])
+    {
+        batch = 64;
+        nparticles = 10000000;
+        seed = 1;
+
+        options = {
+            {"help", no_argument, 0, 'h'},
+            {"batch", required_argument, 0, 'n'},
+            {"particles", required_argument, 0, 'N'},
+            {"seed", required_argument, 0, 's'},
+            {0, 0, 0, 0},
+        };
+
+        int option_index = 0;
+        int opt;
+        while ((opt = getopt_long(argc, argv, "hn:N:s:", options.data(), &option_index)) != -1)
+        {
+            switch (opt)
+            {
+            case 'n':
+            {
+                this->batch = std::clamp(std::stoi(optarg), 1, EventKinematics::MAX_MULTI);
+                break;
+            }
+            case 'N':
+            {
+                this->nparticles = std::max(1L, std::stol(optarg));
+                break;
+            }
+            case 's':
+            {
+                this->seed = std::stoul(optarg);
+                break;
+            }
+            case 'h':
+            {
+                this->help();
+                std::exit(1);
+            }
+            default:
+            {
+                std::cout << "Got unknown option." << std::endl;
+                this->help();
+                std::exit(1);
+            }
+            }
+        }
+    }
+
+    void help()
+    {
+        const char *msg = R"(
+            usage : bench_physics.exe [options]
+            Compare the kinematics of the Float and Double precision policies of Physics on the same particles : the kernels
+            of Physics::Batch (Float at every level supported by the CPU), EventKinematicsT::Fill and ParticleT. Prints the
+            time per particle and the largest deviation of the Float path from the Double path.
+            -n          particles per call of a kernel and per event, at most 128, default 64.
+            -N          particles per kernel and path, default 10000000.
+            -s          seed of the particles (Z <= 4, p / A from 1 MeV/c to 1 GeV/c, isotropic in the cms).
+            -h          Print help message.
+        )";
+        std::cout << msg << std::endl;
+    }
+
+protected:
+    std::vector<option> options;
+};
@@ -1,154 +1,599 @@
 #include "filter_e15190.hh"
 
-struct AMD
-{
-    const static int MAX_MULTI = 128;
-    // base
-    int multi;
-    double b;
-    std::array<int, MAX_MULTI> N;
-    std::array<int, MAX_MULTI> Z;
-    std::array<double, MAX_MULTI> px;
-    std::array<double, MAX_MULTI> py;
-    std::array<double, MAX_MULTI> pz;
-
-    // table3
-    std::array<double, MAX_MULTI> J;
-    std::array<double, MAX_MULTI> M;
-    std::array<double, MAX_MULTI> WEIGHT;
-    std::array<int, MAX_MULTI> iFRG;
-};
 struct E15190
 {
-    const static int MAX_MULTI = 128;
     // impact parameter
     double b;
 
-    // microball
-    int uball_multi;
-    std::array<int, MAX_MULTI> uball_N;
-    std::array<int, MAX_MULTI> uball_Z;
-    std::array<double, MAX_MULTI> uball_px;
-    std::array<double, MAX_MULTI> uball_py;
-    std::array<double, MAX_MULTI> uball_pz;
-
-    // hira
-    int hira_multi;
-    std::array<int, MAX_MULTI> hira_N;
-    std::array<int, MAX_MULTI> hira_Z;
-    std::array<double, MAX_MULTI> hira_px;
-    std::array<double, MAX_MULTI> hira_py;
-    std::array<double, MAX_MULTI> hira_pz;
-
-    // veto wall
-    // neutron wall
+    // one entry per detector of the filter, in the order of the filter configuration
+    std::vector<DetectorHits> detectors;
+};
+
+/**
+ * @brief Columnar store of filtered events, used to hand the output of the worker threads to the tree in order.
+ */
+class FilteredBuffer
+{
+public:
+    std::size_t Size() const { return b.size(); }
+
+    void Push(const E15190 &event)
+    {
+        b.push_back(event.b);
+        columns.resize(event.detectors.size());
+        for (std::size_t i = 0; i < event.detectors.size(); i++)
+        {
+            const DetectorHits &hits = event.detectors[i];
+            Columns &column = columns[i];
+            column.multi.push_back(hits.multi);
+            column.N.insert(column.N.end(), hits.N.begin(), hits.N.begin() + hits.multi);
+            column.Z.insert(column.Z.end(), hits.Z.begin(), hits.Z.begin() + hits.multi);
+            column.px.insert(column.px.end(), hits.px.begin(), hits.px.begin() + hits.multi);
+            column.py.insert(column.py.end(), hits.py.begin(), hits.py.begin() + hits.multi);
+            column.pz.insert(column.pz.end(), hits.pz.begin(), hits.pz.begin() + hits.multi);
+        }
+    }
+
+    // events must be loaded in order, the particle offsets are carried from one call to the next
+    void Load(const std::size_t &ievt, E15190 &event)
+    {
+        event.b = b[ievt];
+
+        auto copy = [](const auto &column, const std::size_t &offset, const int &multi, auto &array)
+        {
+            std::copy(column.begin() + offset, column.begin() + offset + multi, array.begin());
+        };
+        for (std::size_t i = 0; i < columns.size(); i++)
+        {
+            DetectorHits &hits = event.detectors[i];
+            Columns &column = columns[i];
+            if (ievt == 0)
+            {
+                column.offset = 0;
+            }
+            hits.multi = column.multi[ievt];
+            copy(column.N, column.offset, hits.multi, hits.N);
+            copy(column.Z, column.offset, hits.multi, hits.Z);
+            copy(column.px, column.offset, hits.multi, hits.px);
+            copy(column.py, column.offset, hits.multi, hits.py);
+            copy(column.pz, column.offset, hits.multi, hits.pz);
+            column.offset += hits.multi;
+        }
+    }
+
+private:
+    struct Columns
+    {
+        std::size_t offset = 0;
+        std::vector<int> multi, N, Z;
+        std::vector<double> px, py, pz;
+    };
+
+    std::vector<double> b;
+    std::vector<Columns> columns;
+};
+
+/**
+ * @brief Detectors and kinematics of one reaction, everything FilterEvent() needs besides the event itself.
+ */
+struct FilterSetup
+{
+    AME *ame;
+    FilterPipeline *pipeline;
+    EventKinematics *kinematics; // lab-frame columns of the events, boosted from cms
+    double betacms;
+    double rapidity_beam;
+};
+
+/**
+ * @brief State of one filter thread.
+ *
+ * The detectors are cloned from the set-up ones, so that their hit maps, counters and rejection statistics are private to the
+ * thread; the geometry, threshold and mass tables are only read.
+ */
+struct FilterWorker
+{
+    FilterSetup setup;
+    AMD event;
+    E15190 filtered;
+    EventChain *chain = nullptr; // opened by the worker when the input is a list of files
+
+    FilterWorker(const FilterSetup &shared) : setup(shared)
+    {
+        this->setup.ame = new AME(*shared.ame);
+        this->setup.pipeline = new FilterPipeline(*shared.pipeline);
+        this->setup.kinematics = new EventKinematics(*shared.kinematics);
+    }
+    ~FilterWorker()
+    {
+        delete this->setup.ame;
+        delete this->setup.pipeline;
+        delete this->setup.kinematics;
+        delete this->chain;
+    }
+};
+
+/**
+ * @brief Output of one filter run : the tree of filtered events and, with a skim path, the HiRA skim written in the same pass.
+ *
+ * The output has the branches `<prefix>_*` of every detector. The skim needs Microball and HiRA in the filter; it holds
+ *  - "AMD" : the events with HiRA hits, with b, the multiplicities, the hira branches and "entry" in the full tree,
+ *  - "events" : b and the multiplicities of every event, for the normalization,
+ *  - TEntryList "uball_multi_<m>" : the skim entries per Microball multiplicity.
+ */
+class FilterWriter
+{
+public:
+    FilterWriter(const std::string &path_output, const std::string &path_skim, const OutputProfile &profile, const FilterPipeline &pipeline);
+    ~FilterWriter();
+
+    // the event written by Fill()
+    E15190 filtered;
+    void Fill();
+    void Close();
+
+private:
+    TFile *mFile;
+    TTree *mTree;
+
+    TFile *mSkimFile;
+    TTree *mSkimTree;
+    TTree *mEventsTree;
+    std::map<int, TEntryList *> mLists;
+    int mEntry;
+    int mSkimUball, mSkimHiRA; // index of Microball and HiRA in filtered.detectors
 };
 
-AMD amd;
-E15190 filtered_amd;
+void CheckJob(FilterJob &job);
+std::string SkimPath(const std::string &path_output);
+std::vector<FilterJob> ReadManifest(const std::string &path);
+std::vector<DetectorConfig> ReadFilterConfig(const std::string &path);
+bool RunBatch(std::vector<FilterJob> jobs, const int &nthreads, const AME &ame, const MicroballDatabase &database, const std::vector<DetectorConfig> &config, const OutputProfile &profile);
+long Filter(const FilterJob &job, const AME &ame, const MicroballDatabase &database, const std::vector<DetectorConfig> &config, const OutputProfile &profile, const int &nthreads, const bool &verbose);
+
+void Initialize_TChain(EventChain *&chain, const std::vector<std::string> &pths, AMD &event);
+void Initialize_TTree(TTree *&tree, const OutputProfile &profile, E15190 &filtered, const FilterPipeline &pipeline, const bool &skim = false);
+long FilterChainParallel(const std::vector<std::string> &paths, FilterSetup &setup, const int &nthreads, FilterWriter &writer);
+long FilterTable3(const std::vector<std::string> &paths, const std::string &path_raw, const int &amass, FilterSetup &setup, const int &nthreads, FilterWriter &writer);
+template <typename Chunk>
+long FilterOrdered(const std::function<bool(std::size_t &, Chunk &)> &next, const std::function<void(Chunk &, FilterWorker &, FilteredBuffer &)> &process, FilterSetup &setup, const int &nthreads, FilterWriter &writer);
+bool FilterEvent(const AMD &event, E15190 &filtered, FilterSetup &setup);
 
-void Initialize_TChain(TChain *&chain, const std::vector<std::string> &pths);
-void Initialize_TTree(TTree *&tree);
+std::string FindOutdatedAcceptance(const std::string &path, const std::string &reaction, const FilterPipeline &pipeline, const std::vector<std::string> &inputs);
+void BuildAcceptanceTable(const std::string &reaction, const std::string &path, const FilterPipeline &pipeline, const std::vector<std::string> &inputs, const int &nthreads);
 
-void Initialize_MicroBall(Microball *&microball, const std::string &reaction);
-bool ReadMicroballParticle(Microball *&mb, const Particle &part);
-bool ReadHiRAParticle(HiRA *&hira, const Particle &particle);
-void correct_phi_value(Particle &part, Microball *&microball);
+MicroballDatabase ReadMicroballDatabase();
+void Initialize_MicroBall(Microball *&microball, const std::string &reaction, const MicroballDatabase &database);
+FilterPipeline *Initialize_Pipeline(const std::string &reaction, const MicroballDatabase &database, const std::vector<DetectorConfig> &config);
 
 int main(int argc, char *argv[])
 {
-    AME *ame = new AME();
     ArgumentParser argparser(argc, argv);
+    OutputProfile profile = OutputProfile::Get(argparser.profile, argparser.float_momenta);
 
-    TChain *chain = new TChain("AMD");
-    Initialize_TChain(chain, argparser.input_files);
+    // the cuts on theta and phi must not depend on the vector level of the host, so that every machine filters the same events
+    Physics::Batch::SetLevel(Physics::Batch::Scalar);
+
+    // read once, every job copies what it needs; the mass table is loaded first so that the copies share it
+    AME *ame = new AME();
+    ame->Load();
+    MicroballDatabase database = ReadMicroballDatabase();
+    std::vector<DetectorConfig> config = ReadFilterConfig(argparser.path_config);
 
-    double beam_mass = ame->GetMass(argparser.beamZ, argparser.beamA);
-    double target_mass = ame->GetMass(argparser.targetZ, argparser.targetA);
-    double betacms = Physics::GetReactionBeta(beam_mass, target_mass, argparser.beam_energy, argparser.beamA);
-    double rapidity_beam = Physics::GetBeamRapidity(beam_mass, target_mass, argparser.beam_energy, argparser.beamA); // not needed
+    if (argparser.nthreads > 1 || !argparser.job.path_raw.empty())
+    {
+        // the input chains of the workers, the raw tree of the reader thread or the trees of concurrent jobs are used from several threads
+        ROOT::EnableThreadSafety();
+    }
 
-    std::cout << "beam mass: " << beam_mass << std::endl;
-    std::cout << "target mass: " << target_mass << std::endl;
-    std::cout << "beta cms: " << betacms << std::endl;
-    std::cout << "rapidity beam: " << rapidity_beam << std::endl;
+    if (!argparser.path_manifest.empty())
+    {
+        std::vector<FilterJob> jobs = ReadManifest(argparser.path_manifest);
+        for (auto &job : jobs)
+        {
+            job.path_skim = argparser.skim ? SkimPath(job.path_output) : "";
+        }
+        bool success = RunBatch(jobs, argparser.nthreads, *ame, database, config, profile);
+        return success ? 0 : 1;
+    }
 
-    Microball *microball = new Microball();
-    Initialize_MicroBall(microball, argparser.reaction);
-    HiRA *hira = new HiRA();
+    if (!argparser.path_acceptance.empty())
+    {
+        // the files the efficiencies depend on; a change of any of them rebuilds the table
+        std::vector<std::string> inputs = database.files;
+        inputs.insert(inputs.begin(), argparser.path_config);
+        FilterPipeline *pipeline = Initialize_Pipeline(argparser.job.reaction, database, config);
+        std::string outdated = FindOutdatedAcceptance(argparser.path_acceptance, argparser.job.reaction, *pipeline, inputs);
+        if (!outdated.empty())
+        {
+            std::cout << Form("acceptance table %s %s, building it", argparser.path_acceptance.c_str(), outdated.c_str()) << std::endl;
+            BuildAcceptanceTable(argparser.job.reaction, argparser.path_acceptance, *pipeline, inputs, argparser.nthreads);
+        }
+        delete pipeline;
+        if (argparser.job.input_files.empty() && argparser.job.table3_files.empty())
+        {
+            return 0;
+        }
+    }
 
-    TTree *tree = new TTree("AMD", "");
-    Initialize_TTree(tree);
+    FilterJob job = argparser.job;
+    job.path_skim = argparser.skim ? SkimPath(job.path_output) : "";
+    CheckJob(job);
+    long nevents = Filter(job, *ame, database, config, profile, argparser.nthreads, true);
+    std::cout << Form("filtered %ld events", nevents) << std::endl;
+    return 0;
+}
 
-    ProgressBar bar(chain->GetEntries(), argparser.reaction);
-    for (int ievt = 0; ievt < chain->GetEntries(); ievt++)
+/**
+ * @brief Check the inputs of a job and fill in their size.
+ */
+void CheckJob(FilterJob &job)
+{
+    if (job.input_files.empty() == job.table3_files.empty())
     {
-        chain->GetEntry(ievt);
+        std::string msg = Form("%s : expect either input files or table3 files", job.reaction.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    job.input_bytes = 0.;
+    for (const auto &paths : {job.input_files, job.table3_files})
+    {
+        for (const auto &path : paths)
+        {
+            if (!fs::exists(path))
+            {
+                std::string msg = Form("%s does not exists.", path.c_str());
+                throw std::invalid_argument(msg.c_str());
+            }
+            job.input_bytes += fs::file_size(path);
+        }
+    }
+}
+
+/**
+ * @brief Path of the HiRA skim of an output file, e.g. ca48ni64.root -> ca48ni64_hira.root
+ */
+std::string SkimPath(const std::string &path_output)
+{
+    fs::path path(path_output);
+    return (path.parent_path() / (path.stem().string() + "_hira.root")).string();
+}
 
-        microball->ResetCsIHitMap();
-        hira->ResetCounter();
-        for (unsigned int i = 0; i < amd.multi; i++)
+/**
+ * @brief Read a batch manifest, one job per line : reaction path_output path_input [path_input ...]
+ *
+ * Inputs ending in `.dat` are table3 files, the others ROOT or columnar files from amd2root. Empty lines and lines starting with `#` are skipped.
+ */
+std::vector<FilterJob> ReadManifest(const std::string &path)
+{
+    if (!fs::exists(path))
+    {
+        std::string msg = Form("%s does not exists.", path.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    std::ifstream stream(path.c_str());
+    std::vector<FilterJob> jobs;
+
+    std::string line;
+    int iline = 0;
+    while (std::getline(stream, line))
+    {
+        iline++;
+        std::istringstream iss(line);
+        FilterJob job;
+        if (!(iss >> job.reaction) || job.reaction[0] == '#')
+        {
+            continue;
+        }
+        std::string path_input;
+        iss >> job.path_output;
+        while (iss >> path_input)
+        {
+            if (fs::path(path_input).extension() == ".dat")
+                job.table3_files.push_back(path_input);
+            else
+                job.input_files.push_back(path_input);
+        }
+        if (job.path_output.empty() || job.input_files.empty() == job.table3_files.empty())
         {
-            double mass = ame->GetMass(amd.Z[i], amd.N[i] + amd.Z[i]);
-            Particle particle(amd.N[i], amd.Z[i], amd.px[i], amd.py[i], amd.pz[i], mass, "cms");
-            particle.Initialize(betacms, rapidity_beam);
+            std::string msg = Form("%s:%d : expect reaction path_output path_input [path_input ...], with either table3 files or ROOT / columnar files", path.c_str(), iline);
+            throw std::invalid_argument(msg.c_str());
+        }
+        CheckJob(job);
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+/**
+ * @brief Read the detectors of the filter, one per line : name min_hits
+ *
+ * The detectors are filled in the order of the lines; lines starting with `#` and the header line are skipped.
+ * See database/e15190/filter.dat.
+ */
+std::vector<DetectorConfig> ReadFilterConfig(const std::string &path)
+{
+    if (!fs::exists(path))
+    {
+        std::string msg = Form("%s does not exists.", path.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    std::ifstream stream(path.c_str());
+    std::vector<DetectorConfig> config;
+
+    std::string line;
+    int iline = 0;
+    while (std::getline(stream, line))
+    {
+        iline++;
+        std::istringstream iss(line);
+        DetectorConfig detector;
+        if (!(iss >> detector.name) || detector.name[0] == '#' || detector.name == "detector")
+        {
+            continue;
+        }
+        if (!(iss >> detector.min_hits) || detector.min_hits < 0)
+        {
+            std::string msg = Form("%s:%d : expect detector min_hits, with min_hits >= 0", path.c_str(), iline);
+            throw std::invalid_argument(msg.c_str());
+        }
+        config.push_back(detector);
+    }
+    if (config.empty())
+    {
+        std::string msg = Form("%s : no detector in the filter.", path.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    return config;
+}
 
-            // phi is calculated according to microball detector, if the particle is not covered by microball, phi is not correct and should be in the range of [-pi, pi].
-            correct_phi_value(particle, microball);
+/**
+ * @brief Run the jobs of a manifest on a pool of nthreads threads.
+ *
+ * Jobs are started largest input first, so that the long ones do not end up last. Threads left over when there are fewer jobs
+ * filter within the jobs. Returns false if any job failed; the other jobs still run.
+ */
+bool RunBatch(std::vector<FilterJob> jobs, const int &nthreads, const AME &ame, const MicroballDatabase &database, const std::vector<DetectorConfig> &config, const OutputProfile &profile)
+{
+    std::sort(jobs.begin(), jobs.end(), [](const FilterJob &a, const FilterJob &b)
+              { return a.input_bytes > b.input_bytes; });
 
-            int uball_multi = microball->GetCsIHits();
-            int hira_multi = hira->GetCountPass();
+    int nworkers = std::min<int>(nthreads, jobs.size());
+    int nthreads_per_job = std::max(1, nthreads / std::max(1, nworkers));
+    std::cout << Form("running %zu jobs on %d threads", jobs.size(), nworkers) << std::endl;
 
-            if (ReadMicroballParticle(microball, particle))
+    std::mutex mutex;
+    std::size_t next_job = 0;
+    int nfinished = 0;
+    bool success = true;
+    auto start = std::chrono::steady_clock::now();
+
+    auto work = [&]()
+    {
+        while (true)
+        {
+            std::size_t ijob;
             {
-                filtered_amd.uball_N[uball_multi] = particle.N;
-                filtered_amd.uball_Z[uball_multi] = particle.Z;
-                filtered_amd.uball_px[uball_multi] = particle.px;
-                filtered_amd.uball_py[uball_multi] = particle.py;
-                filtered_amd.uball_pz[uball_multi] = particle.pz_lab;
+                std::lock_guard<std::mutex> lock(mutex);
+                if (next_job >= jobs.size())
+                {
+                    return;
+                }
+                ijob = next_job++;
+            }
 
-                double theta_deg = particle.theta_lab * TMath::RadToDeg();
-                double phi_deg = particle.phi * TMath::RadToDeg();
+            FilterJob &job = jobs[ijob];
+            auto job_start = std::chrono::steady_clock::now();
+            std::string report;
+            bool failed = false;
+            try
+            {
+                long nevents = Filter(job, ame, database, config, profile, nthreads_per_job, false);
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - job_start;
+                report = Form("%s -> %s : %ld events in %.2f s", job.reaction.c_str(), job.path_output.c_str(), nevents, elapsed.count());
+            }
+            catch (const std::exception &e)
+            {
+                report = Form("%s -> %s : failed, %s", job.reaction.c_str(), job.path_output.c_str(), e.what());
+                failed = true;
+            }
 
-                microball->AddCsIHit(theta_deg, phi_deg);
+            std::lock_guard<std::mutex> lock(mutex);
+            nfinished++;
+            if (failed)
+            {
+                success = false;
             }
+            std::cout << Form("[%d/%zu] ", nfinished, jobs.size()) << report << std::endl;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < nworkers; i++)
+    {
+        workers.emplace_back(work);
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << Form("filtered %zu jobs in %.2f s", jobs.size(), elapsed.count()) << std::endl;
+    return success;
+}
+
+/**
+ * @brief Filter the inputs of one job into its output file. Returns the number of events written.
+ *
+ * The job builds its own detectors and copy of the mass table, so that jobs can run concurrently.
+ * With verbose, the reaction kinematics and a progress bar are printed.
+ */
+long Filter(const FilterJob &job, const AME &ame, const MicroballDatabase &database, const std::vector<DetectorConfig> &config, const OutputProfile &profile, const int &nthreads, const bool &verbose)
+{
+    ReactionSystem system(job.reaction);
+    FilterSetup setup;
+    setup.ame = new AME(ame);
 
-            if (ReadHiRAParticle(hira, particle))
+    double beam_mass = setup.ame->GetMass(system.beamZ, system.beamA);
+    double target_mass = setup.ame->GetMass(system.targetZ, system.targetA);
+    setup.betacms = Physics::GetReactionBeta(beam_mass, target_mass, system.beam_energy, system.beamA);
+    setup.rapidity_beam = Physics::GetBeamRapidity(beam_mass, target_mass, system.beam_energy, system.beamA); // not needed
+
+    if (verbose)
+    {
+        std::cout << "beam mass: " << beam_mass << std::endl;
+        std::cout << "target mass: " << target_mass << std::endl;
+        std::cout << "beta cms: " << setup.betacms << std::endl;
+        std::cout << "rapidity beam: " << setup.rapidity_beam << std::endl;
+    }
+
+    setup.pipeline = Initialize_Pipeline(job.reaction, database, config);
+    setup.kinematics = new EventKinematics(EventKinematics::CMS, EventKinematics::Phi | EventKinematics::Theta | EventKinematics::Kinergy | EventKinematics::Boost, setup.betacms, setup.rapidity_beam);
+
+    // create the file first so that the baskets are compressed and flushed to disk while filling
+    FilterWriter writer(job.path_output, job.path_skim, profile, *setup.pipeline);
+
+    // if microball multi is 0, in experiment we don't see the event. We still keep the event here (min_hits 0 in the configuration)
+    // as this data can be easily removed in the analysis.
+    long nevents = 0;
+    if (!job.table3_files.empty())
+    {
+        nevents = FilterTable3(job.table3_files, job.path_raw, system.beamA + system.targetA, setup, nthreads, writer);
+    }
+    else if (nthreads > 1)
+    {
+        nevents = FilterChainParallel(job.input_files, setup, nthreads, writer);
+    }
+    else
+    {
+        AMD event;
+        EventChain *chain = new EventChain("AMD");
+        Initialize_TChain(chain, job.input_files, event);
+
+        ProgressBar *bar = verbose ? new ProgressBar(chain->GetEntries(), job.reaction) : nullptr;
+        for (long ievt = 0; ievt < chain->GetEntries(); ievt++)
+        {
+            chain->GetEntry(ievt);
+            if (FilterEvent(event, writer.filtered, setup))
+            {
+                writer.Fill();
+                nevents++;
+            }
+            if (bar != nullptr)
             {
-                filtered_amd.hira_N[hira_multi] = particle.N;
-                filtered_amd.hira_Z[hira_multi] = particle.Z;
-                filtered_amd.hira_px[hira_multi] = particle.px;
-                filtered_amd.hira_py[hira_multi] = particle.py;
-                filtered_amd.hira_pz[hira_multi] = particle.pz_lab;
-                hira->CountPass();
+                bar->Update();
             }
         }
+        delete bar;
+        delete chain;
+    }
+
+    writer.Close();
+
+    delete setup.ame;
+    delete setup.pipeline;
+    delete setup.kinematics;
+    return nevents;
+}
 
-        filtered_amd.hira_multi = hira->GetCountPass();
-        filtered_amd.uball_multi = microball->GetCsIHits();
-        filtered_amd.b = amd.b;
-        // if microball multi is 0, in experiment we don't see the event. We still keep the event here as this data can be easily removed in the analysis.
-        tree->Fill();
-        bar.Update();
+FilterWriter::FilterWriter(const std::string &path_output, const std::string &path_skim, const OutputProfile &profile, const FilterPipeline &pipeline)
+{
+    this->mSkimFile = nullptr;
+    this->mEntry = 0;
+    this->mSkimUball = pipeline.Find("uball");
+    this->mSkimHiRA = pipeline.Find("hira");
+    if (!path_skim.empty() && (this->mSkimUball == -1 || this->mSkimHiRA == -1))
+    {
+        throw std::invalid_argument("the HiRA skim needs microball and hira in the filter.");
+    }
+
+    // the branches point into the hits, which must not move from now on
+    this->filtered.detectors.resize(pipeline.Size());
+    this->mFile = new TFile(path_output.c_str(), "RECREATE");
+    profile.Apply(this->mFile);
+    this->mFile->cd();
+    this->mTree = new TTree("AMD", "");
+    Initialize_TTree(this->mTree, profile, this->filtered, pipeline);
+    profile.Apply(this->mTree);
+
+    if (path_skim.empty())
+    {
+        return;
     }
+    this->mSkimFile = new TFile(path_skim.c_str(), "RECREATE");
+    profile.Apply(this->mSkimFile);
+    this->mSkimFile->cd();
+    this->mSkimTree = new TTree("AMD", "");
+    Initialize_TTree(this->mSkimTree, profile, this->filtered, pipeline, true);
+    this->mSkimTree->Branch("entry", &this->mEntry, "entry/I");
+    profile.Apply(this->mSkimTree);
+    this->mEventsTree = new TTree("events", "");
+    this->mEventsTree->Branch("b", &this->filtered.b, "b/D");
+    for (std::size_t i = 0; i < pipeline.Size(); i++)
+    {
+        std::string name = pipeline.GetDetector(i)->GetPrefix() + "_multi";
+        this->mEventsTree->Branch(name.c_str(), &this->filtered.detectors[i].multi, (name + "/I").c_str());
+    }
+}
 
-    TFile *outputfile = new TFile(argparser.output_file.c_str(), "RECREATE");
-    outputfile->cd();
-    tree->Write();
-    outputfile->Write();
-    outputfile->Close();
+FilterWriter::~FilterWriter()
+{
+    // the trees and entry lists belong to the files
+    delete this->mFile;
+    delete this->mSkimFile;
+}
+
+void FilterWriter::Fill()
+{
+    this->mTree->Fill();
+    if (this->mSkimFile == nullptr)
+    {
+        return;
+    }
+    this->mEventsTree->Fill();
+    if (this->filtered.detectors[this->mSkimHiRA].multi > 0)
+    {
+        int multi = this->filtered.detectors[this->mSkimUball].multi;
+        if (this->mLists.count(multi) == 0)
+        {
+            this->mSkimFile->cd();
+            this->mLists[multi] = new TEntryList(Form("uball_multi_%d", multi), "");
+        }
+        this->mLists[multi]->Enter(this->mSkimTree->GetEntries());
+        this->mSkimTree->Fill();
+    }
+    this->mEntry++;
 }
 
-void Initialize_TChain(TChain *&chain, const std::vector<std::string> &pths)
+void FilterWriter::Close()
 {
-    chain->SetBranchAddress("multi", &amd.multi);
-    chain->SetBranchAddress("b", &amd.b);
-    chain->SetBranchAddress("N", &amd.N[0]);
-    chain->SetBranchAddress("Z", &amd.Z[0]);
-    chain->SetBranchAddress("px", &amd.px[0]);
-    chain->SetBranchAddress("py", &amd.py[0]);
-    chain->SetBranchAddress("pz", &amd.pz[0]);
+    this->mFile->cd();
+    this->mTree->Write();
+    this->mFile->Write();
+    this->mFile->Close();
+    if (this->mSkimFile == nullptr)
+    {
+        return;
+    }
+    this->mSkimFile->cd();
+    this->mSkimTree->Write();
+    this->mEventsTree->Write();
+    for (auto &[multi, list] : this->mLists)
+    {
+        list->Write();
+    }
+    this->mSkimFile->Close();
+}
 
+void Initialize_TChain(EventChain *&chain, const std::vector<std::string> &pths, AMD &event)
+{
+    chain->SetBranchAddress("multi", &event.multi);
+    chain->SetBranchAddress("b", &event.b);
+    chain->SetBranchAddress("N", &event.N[0]);
+    chain->SetBranchAddress("Z", &event.Z[0]);
+    chain->SetBranchAddress("px", &event.px[0]);
+    chain->SetBranchAddress("py", &event.py[0]);
+    chain->SetBranchAddress("pz", &event.pz[0]);
     chain->SetMakeClass(1);
     chain->SetBranchStatus("*", false);
     chain->SetBranchStatus("multi", true);
@@ -170,77 +615,550 @@ void Initialize_TChain(TChain *&chain, const std::vector<std::string> &pths)
     }
 }
 
-void Initialize_TTree(TTree *&tree)
+/**
+ * @brief Branches of the filtered events, `<prefix>_*` for every detector of the pipeline.
+ *
+ * The skim keeps only the multiplicity of the detectors other than HiRA.
+ */
+void Initialize_TTree(TTree *&tree, const OutputProfile &profile, E15190 &filtered, const FilterPipeline &pipeline, const bool &skim)
 {
     // impact parameter
-    tree->Branch("b", &filtered_amd.b, "b/D");
+    tree->Branch("b", &filtered.b, "b/D");
+
+    for (std::size_t i = 0; i < pipeline.Size(); i++)
+    {
+        const std::string &prefix = pipeline.GetDetector(i)->GetPrefix();
+        DetectorHits &hits = filtered.detectors[i];
+        auto branch = [&tree, &prefix](const std::string &name, void *address, const std::string &type, const bool &array)
+        {
+            std::string leaf = prefix + "_" + name + (array ? "[" + prefix + "_multi]/" : "/") + type;
+            tree->Branch((prefix + "_" + name).c_str(), address, leaf.c_str());
+        };
+        branch("multi", &hits.multi, "I", false);
+        if (skim && prefix != "hira")
+        {
+            continue;
+        }
+        branch("N", &hits.N[0], "I", true);
+        branch("Z", &hits.Z[0], "I", true);
+        branch("px", &hits.px[0], profile.MomentumLeaf(), true);
+        branch("py", &hits.py[0], profile.MomentumLeaf(), true);
+        branch("pz", &hits.pz[0], profile.MomentumLeaf(), true);
+    }
+}
+
+/**
+ * @brief Filter one event into filtered with the detectors of setup. Returns false if the pipeline rejects the event.
+ *
+ * The kinematics of all particles are computed first, column by column, then every detector of the pipeline evaluates the
+ * whole event at once; see FilterPipeline.
+ */
+bool FilterEvent(const AMD &event, E15190 &filtered, FilterSetup &setup)
+{
+    EventKinematics &kinematics = *setup.kinematics;
+    kinematics.Fill(event.multi, event.N.data(), event.Z.data(), event.px.data(), event.py.data(), event.pz.data(), *setup.ame);
 
-    // microball
-    tree->Branch("uball_multi", &filtered_amd.uball_multi, "uball_multi/I");
-    tree->Branch("uball_N", &filtered_amd.uball_N[0], "uball_N[uball_multi]/I");
-    tree->Branch("uball_Z", &filtered_amd.uball_Z[0], "uball_Z[uball_multi]/I");
-    tree->Branch("uball_px", &filtered_amd.uball_px[0], "uball_px[uball_multi]/D");
-    tree->Branch("uball_py", &filtered_amd.uball_py[0], "uball_py[uball_multi]/D");
-    tree->Branch("uball_pz", &filtered_amd.uball_pz[0], "uball_pz[uball_multi]/D");
+    FilterParticles particles;
+    particles.n = event.multi;
+    for (int i = 0; i < event.multi; i++)
+    {
+        particles.N[i] = kinematics.N[i];
+        particles.Z[i] = kinematics.Z[i];
+        particles.A[i] = kinematics.A[i];
+        // the momenta of the output as read, not in the precision of the kinematics
+        particles.px[i] = event.px[i] * kinematics.A[i];
+        particles.py[i] = event.py[i] * kinematics.A[i];
+        particles.pz_lab[i] = kinematics.pz_lab[i];
+        particles.theta_deg[i] = kinematics.theta_lab[i] * TMath::RadToDeg();
+        particles.phi[i] = kinematics.phi[i];
+        particles.kinergy_lab[i] = kinematics.kinergy_lab[i];
+    }
 
-    // hira
-    tree->Branch("hira_multi", &filtered_amd.hira_multi, "hira_multi/I");
-    tree->Branch("hira_N", &filtered_amd.hira_N[0], "hira_N[hira_multi]/I");
-    tree->Branch("hira_Z", &filtered_amd.hira_Z[0], "hira_Z[hira_multi]/I");
-    tree->Branch("hira_px", &filtered_amd.hira_px[0], "hira_px[hira_multi]/D");
-    tree->Branch("hira_py", &filtered_amd.hira_py[0], "hira_py[hira_multi]/D");
-    tree->Branch("hira_pz", &filtered_amd.hira_pz[0], "hira_pz[hira_multi]/D");
+    filtered.b = event.b;
+    return setup.pipeline->Filter(particles, filtered.detectors);
 }
 
-void Initialize_MicroBall(Microball *&microball, const std::string &reaction)
+/**
+ * @brief Filter the input files on nthreads workers, each reading its own ranges of entries through its own chain.
+ */
+long FilterChainParallel(const std::vector<std::string> &paths, FilterSetup &setup, const int &nthreads, FilterWriter &writer)
 {
-    fs::path project_dir = std::getenv("PROJECT_DIR");
-    fs::path database_dir = project_dir / "database/e15190/microball/acceptance";
-    fs::path path_config = database_dir / "config.dat";
-    fs::path path_geometry = database_dir / "geometry.dat";
-    fs::path path_threshold = database_dir / "fitted_threshold.dat";
+    EventChain *chain = new EventChain("AMD");
+    AMD event;
+    Initialize_TChain(chain, paths, event);
+    const long nentries = chain->GetEntries();
+    delete chain;
+
+    // a few chunks per thread so that the load stays balanced, small enough that the filtered buffers stay small
+    const long chunk_size = std::clamp<long>(nentries / (8 * nthreads), 1000, 20000);
+
+    std::mutex mutex;
+    long next_entry = 0;
+    std::size_t next_chunk = 0;
+    auto next = [&](std::size_t &ichunk, std::pair<long, long> &range)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (next_entry >= nentries)
+        {
+            return false;
+        }
+        ichunk = next_chunk++;
+        range = {next_entry, std::min(next_entry + chunk_size, nentries)};
+        next_entry = range.second;
+        return true;
+    };
 
-    microball->ConfigurateSetup(reaction, path_config.string());
-    microball->ReadGeometryMap(path_geometry.string());
-    microball->ReadThresholdKinergyMap(path_threshold.string());
+    auto process = [&paths](std::pair<long, long> &range, FilterWorker &worker, FilteredBuffer &output)
+    {
+        if (worker.chain == nullptr)
+        {
+            worker.chain = new EventChain("AMD");
+            Initialize_TChain(worker.chain, paths, worker.event);
+        }
+        for (long ievt = range.first; ievt < range.second; ievt++)
+        {
+            worker.chain->GetEntry(ievt);
+            if (FilterEvent(worker.event, worker.filtered, worker.setup))
+            {
+                output.Push(worker.filtered);
+            }
+        }
+    };
+
+    return FilterOrdered<std::pair<long, long>>(next, process, setup, nthreads, writer);
 }
 
-bool ReadMicroballParticle(Microball *&mb, const Particle &part)
+/**
+ * @brief Filter numbered chunks of events on nthreads workers and fill the tree in chunk order.
+ *
+ * The output does not depend on the number of threads.
+ *
+ * next(ichunk, chunk) is called concurrently by the workers; it hands out the chunks 0, 1, 2, ... and returns false at the end.
+ * process(chunk, worker, output) filters one chunk with the detectors of the worker.
+ */
+template <typename Chunk>
+long FilterOrdered(const std::function<bool(std::size_t &, Chunk &)> &next, const std::function<void(Chunk &, FilterWorker &, FilteredBuffer &)> &process, FilterSetup &setup, const int &nthreads, FilterWriter &writer)
 {
-    double theta_deg = part.theta_lab * TMath::RadToDeg();
-    double phi_deg = part.phi * TMath::RadToDeg();
-    bool pass_charge = mb->IsChargedParticle(part.Z);
-    bool pass_coverage = mb->IsCovered(theta_deg, phi_deg);
-    bool pass_threshold = mb->IsAccepted(part.kinergy_lab, theta_deg, part.N + part.Z, part.Z);
-    return pass_charge && pass_coverage && pass_threshold;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::map<std::size_t, FilteredBuffer> done;
+    std::size_t issued = 0;
+    std::size_t written = 0;
+    int running = nthreads;
+    std::exception_ptr error;
+    const std::size_t window = 2 * nthreads;
+
+    auto work = [&]()
+    {
+        FilterWorker worker(setup);
+        std::size_t ichunk;
+        Chunk chunk;
+        while (next(ichunk, chunk))
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                issued = std::max(issued, ichunk + 1);
+                // do not run ahead of the tree by more than the window, the finished chunks are kept in memory until they are written
+                cv.wait(lock, [&]()
+                        { return ichunk < written + window || error; });
+                if (error)
+                {
+                    // keep draining, so that the producer of the chunks is not blocked
+                    continue;
+                }
+            }
+
+            FilteredBuffer output;
+            try
+            {
+                process(chunk, worker, output);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                error = std::current_exception();
+                cv.notify_all();
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            done[ichunk] = std::move(output);
+            cv.notify_all();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        running--;
+        cv.notify_all();
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < nthreads; i++)
+    {
+        workers.emplace_back(work);
+    }
+
+    long nevents = 0;
+    for (std::size_t ichunk = 0;; ichunk++)
+    {
+        FilteredBuffer output;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&]()
+                    { return done.count(ichunk) || error || (running == 0 && ichunk >= issued); });
+            if (error || done.count(ichunk) == 0)
+            {
+                break;
+            }
+            output = std::move(done[ichunk]);
+            done.erase(ichunk);
+        }
+
+        for (std::size_t ievt = 0; ievt < output.Size(); ievt++)
+        {
+            output.Load(ievt, writer.filtered);
+            writer.Fill();
+        }
+        nevents += output.Size();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        written = ichunk + 1;
+        cv.notify_all();
+    }
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+    return nevents;
 }
 
-bool ReadHiRAParticle(HiRA *&hira, const Particle &particle)
+/**
+ * @brief Filter table3.dat files without an intermediate ROOT file. Returns the number of events written.
+ *
+ * A reader thread parses the tables into numbered batches of events behind a bounded queue. With one thread, the calling thread
+ * filters them itself; otherwise FilterOrdered() spreads them over nthreads workers. With path_raw, the reader thread also
+ * writes the unfiltered events, as amd2root would.
+ */
+long FilterTable3(const std::vector<std::string> &paths, const std::string &path_raw, const int &amass, FilterSetup &setup, const int &nthreads, FilterWriter &writer)
 {
-    double theta_deg = particle.theta_lab * TMath::RadToDeg();
-    double phi_deg = particle.phi * TMath::RadToDeg();
-    return hira->PassAngularCut(theta_deg, phi_deg) && hira->PassCharged(particle.Z) && hira->PassKinergyCut(particle.Z + particle.N, particle.Z, particle.kinergy_lab);
+    using Batch = std::pair<std::size_t, EventBuffer<TableMode::Table3>>;
+    const std::size_t batch_size = 256;
+    BoundedQueue<Batch> queue(16 + 2 * nthreads);
+    std::exception_ptr reader_error;
+
+    auto read = [&]()
+    {
+        try
+        {
+            EventWriter *raw = path_raw.empty() ? nullptr : new EventWriter(path_raw, "3");
+            AMD local_event;
+            AMD &event = (raw != nullptr) ? raw->event : local_event;
+            std::size_t ibatch = 0;
+            for (const auto &path : paths)
+            {
+                MappedFile file(path);
+                file.AdviseSequential();
+                auto [begin, end] = GetTableRange(file, 0, TableMode::Table3::has_header);
+                Tokenizer tokens(begin, end);
+
+                EventBuffer<TableMode::Table3> batch;
+                auto push = [&]()
+                {
+                    batch.Push(event);
+                    if (raw != nullptr)
+                    {
+                        raw->Fill();
+                    }
+                    if (batch.Size() == batch_size)
+                    {
+                        queue.Push({ibatch++, std::move(batch)});
+                        batch = EventBuffer<TableMode::Table3>();
+                    }
+                    file.ReadAhead(tokens.Position());
+                };
+                ParseEvents<TableMode::Table3>(tokens, event, amass, push, file.Begin());
+                if (batch.Size() > 0)
+                {
+                    queue.Push({ibatch++, std::move(batch)});
+                }
+            }
+            if (raw != nullptr)
+            {
+                // the offset into the last file is not a checkpoint of all of them
+                raw->offset = -1;
+                raw->Close();
+                delete raw;
+            }
+        }
+        catch (...)
+        {
+            reader_error = std::current_exception();
+        }
+        queue.Close();
+    };
+    std::thread reader(read);
+
+    long nevents = 0;
+    std::exception_ptr filter_error;
+    try
+    {
+        if (nthreads > 1)
+        {
+            auto next = [&queue](std::size_t &ibatch, EventBuffer<TableMode::Table3> &batch)
+            {
+                Batch item;
+                if (!queue.Pop(item))
+                {
+                    return false;
+                }
+                ibatch = item.first;
+                batch = std::move(item.second);
+                return true;
+            };
+            auto process = [](EventBuffer<TableMode::Table3> &batch, FilterWorker &worker, FilteredBuffer &output)
+            {
+                for (std::size_t ievt = 0; ievt < batch.Size(); ievt++)
+                {
+                    batch.Load(ievt, worker.event);
+                    if (FilterEvent(worker.event, worker.filtered, worker.setup))
+                    {
+                        output.Push(worker.filtered);
+                    }
+                }
+            };
+            nevents = FilterOrdered<EventBuffer<TableMode::Table3>>(next, process, setup, nthreads, writer);
+        }
+        else
+        {
+            AMD event;
+            Batch item;
+            while (queue.Pop(item))
+            {
+                EventBuffer<TableMode::Table3> &batch = item.second;
+                for (std::size_t ievt = 0; ievt < batch.Size(); ievt++)
+                {
+                    batch.Load(ievt, event);
+                    if (FilterEvent(event, writer.filtered, setup))
+                    {
+                        writer.Fill();
+                        nevents++;
+                    }
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        // drain the queue so that the reader thread can finish
+        filter_error = std::current_exception();
+        Batch item;
+        while (queue.Pop(item))
+        {
+        }
+    }
+    reader.join();
+    if (filter_error)
+    {
+        std::rethrow_exception(filter_error);
+    }
+    if (reader_error)
+    {
+        std::rethrow_exception(reader_error);
+    }
+    return nevents;
 }
 
-void correct_phi_value(Particle &part, Microball *&microball)
+
+/**
+ * @brief Why the acceptance table at path cannot be used for the reaction and pipeline, empty if it can.
+ *
+ * The table is outdated if it is missing or unreadable, of another reaction or other detectors, or built from other inputs
+ * or older versions of them.
+ */
+std::string FindOutdatedAcceptance(const std::string &path, const std::string &reaction, const FilterPipeline &pipeline, const std::vector<std::string> &inputs)
 {
-    double theta_deg = part.theta_lab * TMath::RadToDeg();
-    double phi_deg = part.phi * TMath::RadToDeg();
+    if (!fs::exists(path))
+    {
+        return "does not exist";
+    }
+    AcceptanceTable *table;
+    try
+    {
+        table = new AcceptanceTable(path);
+    }
+    catch (const std::invalid_argument &error)
+    {
+        return Form("is unreadable (%s)", error.what());
+    }
+    std::vector<std::string> detectors;
+    for (std::size_t i = 0; i < pipeline.Size(); i++)
+    {
+        detectors.push_back(pipeline.GetDetector(i)->GetPrefix());
+    }
+    std::string changed = table->FindChangedInput();
+    std::string outdated;
+    if (table->GetReaction() != reaction)
+    {
+        outdated = Form("is of %s", table->GetReaction().c_str());
+    }
+    else if (table->GetDetectors() != detectors)
+    {
+        outdated = "is of other detectors";
+    }
+    else if (!table->HasInputs(inputs))
+    {
+        outdated = "is of another configuration";
+    }
+    else if (!changed.empty())
+    {
+        outdated = Form("is older than %s", changed.c_str());
+    }
+    delete table;
+    return outdated;
+}
 
-    int ring = microball->GetRingID(theta_deg);
-    if (ring == -1)
+/**
+ * @brief Tabulate the single-particle acceptance of the detectors of the pipeline for a reaction and write it to path, see AcceptanceTable.hh.
+ *
+ * Every bin is sampled on a grid of nsample^3 points with the same cuts and phi shifts as FilterEvent(); its efficiency is the
+ * fraction of accepted points. The detectors are named by their prefix. The (theta, phi) cells are spread over nthreads threads.
+ */
+void BuildAcceptanceTable(const std::string &reaction, const std::string &path, const FilterPipeline &pipeline, const std::vector<std::string> &inputs, const int &nthreads)
+{
+    const int nsample = 3;
+    std::vector<std::string> detectors;
+    for (std::size_t i = 0; i < pipeline.Size(); i++)
     {
-        return;
+        detectors.push_back(pipeline.GetDetector(i)->GetPrefix());
     }
-    double phi_min_in_ring = microball->GetPhiMinInRing(ring);
-    double phi_max_in_ring = microball->GetPhiMaxInRing(ring);
+    AcceptanceTable table(reaction, detectors, {180, 0., 180.}, {36, -180., 180.}, {80, 0., 400.});
+    table.SetInputs(inputs);
+    const AcceptanceTable::Axis &theta_axis = table.GetThetaAxis();
+    const AcceptanceTable::Axis &phi_axis = table.GetPhiAxis();
+    const AcceptanceTable::Axis &kinergy_axis = table.GetKinergyAxis();
 
-    if (phi_deg < phi_min_in_ring)
+    const int ncells = theta_axis.nbins * phi_axis.nbins;
+    const int npoints = nsample * nsample * nsample;
+    // kinergy bins of one (theta, phi) cell evaluated at once, as many as fit in one event of the pipeline
+    const int nkinergy = FilterParticles::MAX_MULTI / npoints;
+    std::atomic<int> next_cell(0);
+    auto work = [&]()
     {
-        part.phi += 2. * TMath::Pi();
+        FilterPipeline local(pipeline);
+        FilterParticles particles;
+        std::array<uint8_t, FilterParticles::MAX_MULTI> mask;
+
+        for (int cell = next_cell++; cell < ncells; cell = next_cell++)
+        {
+            int itheta = cell / phi_axis.nbins;
+            int iphi = cell % phi_axis.nbins;
+            for (int species = 0; species < Species::NumNuclei; species++)
+            {
+                for (int kinergy_first = 0; kinergy_first < kinergy_axis.nbins; kinergy_first += nkinergy)
+                {
+                    int kinergy_last = std::min(kinergy_first + nkinergy, kinergy_axis.nbins);
+                    particles.n = (kinergy_last - kinergy_first) * npoints;
+                    for (std::size_t i = 0; i < particles.n; i++)
+                    {
+                        int ikinergy = kinergy_first + i / npoints;
+                        int j = i % npoints;
+                        particles.A[i] = Species::TABLE[species].A;
+                        particles.Z[i] = Species::TABLE[species].Z;
+                        particles.theta_deg[i] = theta_axis.Low(itheta) + (j / (nsample * nsample) + 0.5) * theta_axis.Width() / nsample;
+                        particles.phi[i] = (phi_axis.Low(iphi) + (j / nsample % nsample + 0.5) * phi_axis.Width() / nsample) * TMath::DegToRad();
+                        particles.kinergy_lab[i] = (kinergy_axis.Low(ikinergy) + (j % nsample + 0.5) * kinergy_axis.Width() / nsample) * particles.A[i];
+                    }
+                    local.Prepare(particles);
+
+                    for (std::size_t d = 0; d < local.Size(); d++)
+                    {
+                        local.GetDetector(d)->Accept(particles, mask.data());
+                        float *row = table.Row(d, species, itheta, iphi);
+                        for (int ikinergy = kinergy_first; ikinergy < kinergy_last; ikinergy++)
+                        {
+                            int pass = 0;
+                            for (int j = 0; j < npoints; j++)
+                            {
+                                pass += mask[(ikinergy - kinergy_first) * npoints + j];
+                            }
+                            row[ikinergy] = static_cast<float>(pass) / npoints;
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < nthreads; i++)
+    {
+        workers.emplace_back(work);
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
     }
-    if (phi_deg > phi_max_in_ring)
+    table.Write(path);
+    std::cout << Form("acceptance table of %s written to %s", reaction.c_str(), path.c_str()) << std::endl;
+}
+
+MicroballDatabase ReadMicroballDatabase()
+{
+    if (std::getenv("PROJECT_DIR") == nullptr)
+    {
+        std::string msg = "PROJECT_DIR is not set, cannot read the Microball database.";
+        throw std::invalid_argument(msg.c_str());
+    }
+    fs::path project_dir = std::getenv("PROJECT_DIR");
+    fs::path database_dir = project_dir / "database/e15190/microball/acceptance";
+    fs::path path_config = database_dir / "config.dat";
+    fs::path path_geometry = database_dir / "geometry.dat";
+    fs::path path_threshold = database_dir / "fitted_threshold.dat";
+
+    MicroballDatabase database;
+    database.ReadConfig(path_config.string());
+    database.ReadGeometry(path_geometry.string());
+    database.ReadThreshold(path_threshold.string());
+    return database;
+}
+
+void Initialize_MicroBall(Microball *&microball, const std::string &reaction, const MicroballDatabase &database)
+{
+    microball->ConfigurateSetup(reaction, database);
+    microball->ReadGeometryMap(database);
+    microball->ReadThresholdKinergyMap(database);
+}
+
+/**
+ * @brief Detectors of the filter of a reaction, in the order of config.
+ *
+ * A new detector is a DetectorFilter (see DetectorFilter.hh) with a name here; it is filled in the same pass over the events as the others.
+ */
+FilterPipeline *Initialize_Pipeline(const std::string &reaction, const MicroballDatabase &database, const std::vector<DetectorConfig> &config)
+{
+    FilterPipeline *pipeline = new FilterPipeline();
+    for (const auto &detector : config)
     {
-        part.phi -= 2. * TMath::Pi();
+        if (detector.name == "microball")
+        {
+            Microball *microball = new Microball();
+            Initialize_MicroBall(microball, reaction, database);
+            pipeline->Add(new MicroballFilter(microball), detector.min_hits);
+        }
+        else if (detector.name == "hira")
+        {
+            pipeline->Add(new HiRAFilter(new HiRA()), detector.min_hits);
+        }
+        else
+        {
+            delete pipeline;
+            std::string msg = Form("unknown detector %s in the filter configuration, expect microball or hira.", detector.name.c_str());
+            throw std::invalid_argument(msg.c_str());
+        }
     }
-}
\ No newline at end of file
+    return pipeline;
+}
@@ -1,74 +1,246 @@
 #include "AME.hh"
 #include "HiRA.hh"
 #include "Particle.hh"
+#include "EventKinematics.hh"
 #include "Physics.hh"
 #include "Microball.hh"
 #include "ProgressBar.cpp"
+#include "EventChain.hh"
+#include "OutputProfile.hh"
+#include "AMDTable.hh"
+#include "EventWriter.hh"
+#include "BoundedQueue.hh"
+#include "AcceptanceTable.hh"
+#include "DetectorFilter.hh"
 
 #include "TChain.h"
 #include "TFile.h"
 #include "TTree.h"
+#include "TEntryList.h"
+#include "TROOT.h"
 #include "TString.h"
 
 #include <map>
+#include <chrono>
+#include <sstream>
+#include <regex>
 #include <vector>
 #include <string>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <exception>
 #include <stdlib.h>
 #include <getopt.h>
 #include <filesystem>
 namespace fs = std::filesystem;
 
-class ArgumentParser
+// one filter run : the -r, -i / -t, -w and -o arguments, or one line of a batch manifest
+struct FilterJob
 {
-public:
-    // required arguments
     std::string reaction;
-    std::vector<std::string> input_files;
-    std::string output_file;
+    std::vector<std::string> input_files;  // ROOT or columnar files from amd2root
+    std::vector<std::string> table3_files; // table3.dat files filtered directly, replace input_files
+    std::string path_output;
+    std::string path_raw; // optional unfiltered output of table3_files
+    std::string path_skim; // optional HiRA skim, see FilterWriter
+
+    // total size of the inputs, filled by CheckJob()
+    double input_bytes = 0.;
+};
+
+// one line of the filter configuration : a detector and the hits an event needs in it to be written
+struct DetectorConfig
+{
+    std::string name;
+    int min_hits = 0;
+};
 
+// beam, target and beam energy of a reaction tag, e.g. Ca48Ni64E140
+struct ReactionSystem
+{
     std::string beam;
     std::string target;
     int beamA, beamZ, targetA, targetZ, beam_energy;
 
+    ReactionSystem(const std::string &reaction)
+    {
+        {
+            std::regex pattern("[A-Z][a-z]");
+            std::vector<std::string> tokens;
+            std::sregex_iterator iter(reaction.begin(), reaction.end(), pattern);
+            std::sregex_iterator end;
+
+            while (iter != end)
+            {
+                std::smatch match = *iter;
+                tokens.push_back(match.str());
+                ++iter;
+            }
+
+            this->beam = tokens[0];
+            this->target = tokens[1];
+
+            auto GetZ = [](const std::string &nuclei) -> double
+            {
+                if (nuclei == "Ca")
+                    return 20;
+                else if (nuclei == "Ni")
+                    return 28;
+                else if (nuclei == "Sn")
+                    return 50;
+                else
+                    return 0;
+            };
+            this->beamZ = GetZ(tokens[0]);
+            this->targetZ = GetZ(tokens[1]);
+        }
+
+        {
+            std::regex pattern("[0-9]+");
+            std::vector<int> tokens;
+
+            std::sregex_iterator iter(reaction.begin(), reaction.end(), pattern);
+            std::sregex_iterator end;
+
+            while (iter != end)
+            {
+                std::smatch match = *iter;
+                tokens.push_back(std::stoi(match.str()));
+                ++iter;
+            }
+            this->beamA = tokens[0];
+            this->targetA = tokens[1];
+            this->beam_energy = tokens[2];
+        }
+    }
+};
+
+class ArgumentParser
+{
+public:
+    // required arguments, unless path_manifest is given
+    FilterJob job;
+
+    // manifest of jobs for batch mode, replaces -r, -i, -t and -o
+    std::string path_manifest;
+
+    // compression and basket settings of the output tree, see OutputProfile.hh
+    std::string profile;
+    bool float_momenta;
+
+    // number of filter threads, the output does not depend on it
+    int nthreads;
+
+    // also write the HiRA skim of every job next to its output, as <output>_hira.root
+    bool skim;
+
+    // acceptance table of the reaction, built if it does not exist yet, see AcceptanceTable.hh
+    std::string path_acceptance;
+
+    // detectors of the filter, see ReadFilterConfig()
+    std::string path_config;
+
     ArgumentParser(int argc, char *argv[])
     {
-        reaction = "";
-        input_files = {};
-        output_file = "";
+        profile = "default";
+        float_momenta = false;
+        nthreads = 1;
+        skim = false;
 
         options = {
             {"help", no_argument, 0, 'h'},
             {"reaction", required_argument, 0, 'r'},
             {"input", required_argument, 0, 'i'},
+            {"table3", required_argument, 0, 't'},
+            {"raw", required_argument, 0, 'w'},
             {"output", required_argument, 0, 'o'},
+            {"batch", required_argument, 0, 'b'},
+            {"profile", required_argument, 0, 'p'},
+            {"float-momenta", no_argument, 0, 'f'},
+            {"threads", required_argument, 0, 'j'},
+            {"acceptance", required_argument, 0, 'a'},
+            {"skim", no_argument, 0, 's'},
+            {"config", required_argument, 0, 'c'},
             {0, 0, 0, 0},
         };
 
         int option_index = 0;
         int opt;
-        while ((opt = getopt_long(argc, argv, "hr:i:o:", options.data(), &option_index)) != -1)
+        while ((opt = getopt_long(argc, argv, "hr:i:t:w:o:b:p:fj:a:sc:", options.data(), &option_index)) != -1)
         {
             switch (opt)
             {
 
             case 'r':
             {
-                this->reaction = optarg;
-                this->_Initialize_ReactionSystem(this->reaction);
+                this->job.reaction = optarg;
                 break;
             }
             case 'i':
             {
-                this->input_files.push_back(optarg);
+                this->job.input_files.push_back(optarg);
+                while (optind < argc && *argv[optind] != '-')
+                {
+                    this->job.input_files.push_back(argv[optind++]);
+                }
+                break;
+            }
+            case 't':
+            {
+                this->job.table3_files.push_back(optarg);
                 while (optind < argc && *argv[optind] != '-')
                 {
-                    this->input_files.push_back(argv[optind++]);
+                    this->job.table3_files.push_back(argv[optind++]);
                 }
                 break;
             }
+            case 'w':
+            {
+                this->job.path_raw = optarg;
+                break;
+            }
             case 'o':
             {
-                this->output_file = optarg;
+                this->job.path_output = optarg;
+                break;
+            }
+            case 'b':
+            {
+                this->path_manifest = optarg;
+                break;
+            }
+            case 'p':
+            {
+                this->profile = optarg;
+                break;
+            }
+            case 'f':
+            {
+                this->float_momenta = true;
+                break;
+            }
+            case 'j':
+            {
+                this->nthreads = std::max(1, std::stoi(optarg));
+                break;
+            }
+            case 'a':
+            {
+                this->path_acceptance = optarg;
+                break;
+            }
+            case 's':
+            {
+                this->skim = true;
+                break;
+            }
+            case 'c':
+            {
+                this->path_config = optarg;
                 break;
             }
             case '?':
@@ -89,22 +261,49 @@ public:
             }
         }
 
-        if (this->reaction.empty())
+        if (this->path_config.empty())
+        {
+            if (std::getenv("PROJECT_DIR") == nullptr)
+            {
+                std::string msg = "PROJECT_DIR is not set, cannot find the default filter configuration; give it with -c.";
+                throw std::invalid_argument(msg.c_str());
+            }
+            this->path_config = (fs::path(std::getenv("PROJECT_DIR")) / "database/e15190/filter.dat").string();
+        }
+
+        if (!this->path_manifest.empty() && !this->path_acceptance.empty())
+        {
+            std::cout << "Acceptance table (-a) is built for one reaction (-r), not in batch mode." << std::endl;
+            this->help();
+            std::exit(1);
+        }
+        if (!this->path_manifest.empty())
+        {
+            return;
+        }
+        if (this->job.reaction.empty())
         {
             std::cout << "Reaction tag is required." << std::endl;
             this->help();
         }
-        if (this->input_files.empty())
+        if (!this->path_acceptance.empty() && this->job.input_files.empty() && this->job.table3_files.empty())
         {
-            std::cout << "Input files are required." << std::endl;
+            // only the acceptance table
+            return;
+        }
+        if (this->job.input_files.empty() == this->job.table3_files.empty())
+        {
+            std::cout << "Either input files (-i) or table3 files (-t) are required." << std::endl;
             this->help();
         }
-        if (this->output_file.empty())
+        if (this->job.path_output.empty())
         {
             std::cout << "Output file is required." << std::endl;
             this->help();
         }
-        for (auto pth : this->input_files)
+        std::vector<std::string> all_inputs = this->job.input_files;
+        all_inputs.insert(all_inputs.end(), this->job.table3_files.begin(), this->job.table3_files.end());
+        for (auto pth : all_inputs)
         {
             if (!fs::exists(pth))
             {
@@ -118,65 +317,30 @@ public:
     {
         const char *msg = R"(
             -r      reaction tag, e.g. Ca48Ni64E140
-            -i      a list of input ROOT files, separated by space.
+            -i      a list of input ROOT files or columnar files (.amdc) from amd2root, separated by space.
+            -t      a list of table3.dat files, filtered directly without converting them with amd2root first; replaces -i.
+            -w      with -t, also write the unfiltered events to this path (ROOT or .amdc), as amd2root would.
             -o      ROOT file output path.
+            -p      output profile : default, fast-write, fast-read or smallest (compression, basket and cluster size).
+            -f      store momenta as float32 on disk (Double32_t, still read as double).
+            -b      batch mode, filter every job of the manifest, replaces -r, -i, -t and -o. One job per line :
+                    `reaction path_output path_input [path_input ...]`, inputs ending in .dat are table3 files.
+                    Lines starting with # are skipped. The Microball database and the mass table are read once for all jobs.
+            -j      number of filter threads (default 1); events are written in input order.
+                    With -b, the jobs run concurrently on these threads.
+            -s      also write a HiRA skim of every output, <output>_hira.root : the events with HiRA hits without the Microball particles,
+                    b and multiplicities of every event, and a TEntryList of the skim per Microball multiplicity.
+            -c      filter configuration (default $PROJECT_DIR/database/e15190/filter.dat), one detector per line : `name min_hits`.
+                    The detectors (microball, hira) are filled in this order into their branches; events with fewer than min_hits hits
+                    in a detector are not written, and the detector that rejects the most events is evaluated first.
+            -a      acceptance table (.acc) of the reaction : efficiency of every detector of the filter per species, theta, phi and kinergy,
+                    built on the -j threads if the file does not exist, belongs to another reaction or other detectors, or is older than
+                    the filter configuration or the Microball database. Without -i or -t, only the table is built.
             -h      Print help message.
         )";
         std::cout << msg << std::endl;
     }
 
-    void _Initialize_ReactionSystem(const std::string &reaction)
-    {
-        {
-            std::regex pattern("[A-Z][a-z]");
-            std::vector<std::string> tokens;
-            std::sregex_iterator iter(reaction.begin(), reaction.end(), pattern);
-            std::sregex_iterator end;
-
-            while (iter != end)
-            {
-                std::smatch match = *iter;
-                tokens.push_back(match.str());
-                ++iter;
-            }
-
-            this->beam = tokens[0];
-            this->target = tokens[1];
-
-            auto GetZ = [](const std::string &nuclei) -> double
-            {
-                if (nuclei == "Ca")
-                    return 20;
-                else if (nuclei == "Ni")
-                    return 28;
-                else if (nuclei == "Sn")
-                    return 50;
-                else
-                    return 0;
-            };
-            this->beamZ = GetZ(tokens[0]);
-            this->targetZ = GetZ(tokens[1]);
-        }
-
-        {
-            std::regex pattern("[0-9]+");
-            std::vector<int> tokens;
-
-            std::sregex_iterator iter(reaction.begin(), reaction.end(), pattern);
-            std::sregex_iterator end;
-
-            while (iter != end)
-            {
-                std::smatch match = *iter;
-                tokens.push_back(std::stoi(match.str()));
-                ++iter;
-            }
-            this->beamA = tokens[0];
-            this->targetA = tokens[1];
-            this->beam_energy = tokens[2];
-        }
-    }
-
 protected:
     std::vector<option> options;
 };
\ No newline at end of file
@@ -0,0 +1,50 @@
+# Generates src/AMELight.hh, the masses of ame_mass.txt up to Z = ZMAX compiled into the programs, see AME.hh.
+# usage : awk -f embed_ame_mass.awk ame_mass.txt > ${PROJECT_DIR}/src/AMELight.hh
+# The bin and analysis makefiles regenerate it when ame_mass.txt changes.
+BEGIN {
+    ZMAX = 28
+    n = 0
+    amax = 0
+}
+NR == 1 {
+    next
+}
+$2 <= ZMAX {
+    symbol[n] = $1
+    Z[n] = $2
+    A[n] = $3
+    # copied as written, so that the compiler rounds it as the runtime table does
+    mass[n] = $4
+    n++
+    amax = ($3 > amax) ? $3 : amax
+}
+END {
+    print "// generated by database/ame/embed_ame_mass.awk from database/ame/ame_mass.txt, do not edit"
+    print "#ifndef AMELight_hh"
+    print "#define AMELight_hh"
+    print ""
+    print "#include <array>"
+    print ""
+    print "/**"
+    print " * @brief Masses of the nuclei up to Z = " ZMAX " of the Atomic Mass Evaluation (MeV/c^2), compiled in for the hot loops, see AME::GetMass()."
+    print " */"
+    print "namespace AMELight"
+    print "{"
+    print "    struct Entry"
+    print "    {"
+    print "        int Z, A;"
+    print "        double mass;"
+    print "    };"
+    print ""
+    printf "    constexpr int NZ = %d;\n", ZMAX + 1
+    printf "    constexpr int NA = %d;\n", amax + 1
+    printf "    constexpr std::array<Entry, %d> TABLE = {{\n", n
+    for (i = 0; i < n; i++)
+    {
+        printf "        {%d, %d, %s}, // %s\n", Z[i], A[i], mass[i], symbol[i]
+    }
+    print "    }};"
+    print "}"
+    print ""
+    print "#endif"
+}
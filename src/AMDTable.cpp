@@ -0,0 +1,51 @@
+#include "AMDTable.hh"
+
+/**
+ * @brief Range of a table still to be read : from offset, e.g. the checkpoint of an EventWriter, to the end of the last complete line.
+ *
+ * A table that is still being written may end in a partial line, which must not be parsed yet.
+ * At offset 0 the header line, if any, is skipped.
+ */
+std::pair<const char *, const char *> GetTableRange(const MappedFile &file, const long &offset, const bool &has_header)
+{
+    if (offset > (long)file.Size())
+    {
+        std::string msg = Form("checkpoint at byte %ld is beyond the end of the input (%zu bytes)", offset, file.Size());
+        throw std::invalid_argument(msg.c_str());
+    }
+    const char *end = file.End();
+    while (end != file.Begin() && *(end - 1) != '\n')
+    {
+        end--;
+    }
+
+    Tokenizer tokens(file.Begin() + offset, end);
+    if (has_header && offset == 0)
+    {
+        tokens.SkipLine();
+    }
+    return {tokens.Position(), end};
+}
+
+
+long GetTableHash(const MappedFile &file, const long &offset)
+{
+    const long window = 64 << 10;
+    const long size = std::min<long>(offset, file.Size());
+    uint64_t hash = 14695981039346656037ULL;
+    if (size <= 0)
+    {
+        return static_cast<long>(hash);
+    }
+    auto add = [&hash, &file](const long &begin, const long &end)
+    {
+        for (const char *pos = file.Begin() + begin; pos != file.Begin() + end; pos++)
+        {
+            hash = (hash ^ static_cast<unsigned char>(*pos)) * 1099511628211ULL;
+        }
+    };
+    add(0, std::min(size, window));
+    // the last window, without the bytes of the first one when the table is shorter than two windows
+    add(std::max(std::min(size, window), size - window), size);
+    return static_cast<long>(hash);
+}
@@ -0,0 +1,293 @@
+#ifndef AMDTable_hh
+#define AMDTable_hh
+
+#include <array>
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include "TString.h"
+#include "MappedFile.hh"
+#include "Tokenizer.hh"
+
+/**
+ * @brief Reading of the AMD tables (table21.dat, table3.dat) shared by amd2root and filter_e15190.
+ */
+
+// one event of table21 / table3 / table21t, bound to the branches of the AMD tree
+struct AMD
+{
+    const static int MAX_MULTI = 128;
+    // base
+    int multi;
+    double b;
+    std::array<int, MAX_MULTI> N;
+    std::array<int, MAX_MULTI> Z;
+    std::array<double, MAX_MULTI> px;
+    std::array<double, MAX_MULTI> py;
+    std::array<double, MAX_MULTI> pz;
+
+    // table21
+    std::array<double, MAX_MULTI> ENG;
+    std::array<double, MAX_MULTI> LANG;
+    std::array<double, MAX_MULTI> JX;
+    std::array<double, MAX_MULTI> JY;
+    std::array<double, MAX_MULTI> JZ;
+
+    // table3
+    std::array<double, MAX_MULTI> J;
+    std::array<double, MAX_MULTI> M;
+    std::array<double, MAX_MULTI> WEIGHT;
+    std::array<int, MAX_MULTI> iFRG;
+
+    // table21t
+    std::array<double, MAX_MULTI> t;
+    std::array<double, MAX_MULTI> x;
+    std::array<double, MAX_MULTI> y;
+    std::array<double, MAX_MULTI> z;
+};
+
+/**
+ * @brief Compile-time description of the table modes.
+ *
+ * The mode string of the command line is dispatched once with WithTableMode(); parsing, buffering and the branch setup
+ * are then specialized per mode.
+ */
+namespace TableMode
+{
+    // result of ReadRow()
+    enum Row
+    {
+        Particle,   // one particle was read
+        End,        // end of the range, possibly after an incomplete row
+        Terminator, // a `0 0` record, which ends the table
+        Invalid,    // a token that is not a number or is out of range, at tokens.Position()
+    };
+
+    inline Row Failure(Tokenizer &tokens)
+    {
+        return tokens.AtEnd() ? End : Invalid;
+    }
+
+    struct Table21
+    {
+        static constexpr const char *name = "21";
+        static constexpr bool has_table21 = true;
+        static constexpr bool has_table3 = false;
+        static constexpr bool has_spacetime = false;
+        static constexpr bool has_header = false;
+        static constexpr int column_eventID = 11;
+
+        // read one particle into event[i]
+        static Row ReadRow(Tokenizer &tokens, AMD &event, const int &i, int &eventID)
+        {
+            if (!(tokens.Read(event.Z[i]) && tokens.Read(event.N[i])))
+            {
+                return Failure(tokens);
+            }
+            if (event.Z[i] == 0 && event.N[i] == 0)
+            {
+                return Terminator;
+            }
+            bool read = tokens.Read(event.px[i]) && tokens.Read(event.py[i]) && tokens.Read(event.pz[i]) &&
+                        tokens.Read(event.ENG[i]) && tokens.Read(event.LANG[i]) && tokens.Read(event.JX[i]) && tokens.Read(event.JY[i]) && tokens.Read(event.JZ[i]) &&
+                        tokens.Read(event.b) && tokens.Read(eventID);
+            return read ? Particle : Failure(tokens);
+        }
+    };
+
+    struct Table3
+    {
+        static constexpr const char *name = "3";
+        static constexpr bool has_table21 = false;
+        static constexpr bool has_table3 = true;
+        static constexpr bool has_spacetime = false;
+        static constexpr bool has_header = true;
+        static constexpr int column_eventID = 9;
+
+        static Row ReadRow(Tokenizer &tokens, AMD &event, const int &i, int &eventID)
+        {
+            if (!(tokens.Read(event.Z[i]) && tokens.Read(event.N[i])))
+            {
+                return Failure(tokens);
+            }
+            if (event.Z[i] == 0 && event.N[i] == 0)
+            {
+                return Terminator;
+            }
+            bool read = tokens.Read(event.px[i]) && tokens.Read(event.py[i]) && tokens.Read(event.pz[i]) &&
+                        tokens.Read(event.J[i]) && tokens.Read(event.M[i]) && tokens.Read(event.WEIGHT[i]) &&
+                        tokens.Read(event.b) && tokens.Read(eventID) && tokens.Read(event.iFRG[i]);
+            return read ? Particle : Failure(tokens);
+        }
+    };
+
+    // table21 joined with the collision history, the rows of table21.dat are read as in mode 21
+    struct Table21t : Table21
+    {
+        static constexpr const char *name = "21t";
+        static constexpr bool has_spacetime = true;
+    };
+};
+
+/**
+ * @brief Call callable(TableMode::TableXX()) for the mode string "21", "3" or "21t".
+ */
+template <typename Callable>
+auto WithTableMode(const std::string &mode, Callable &&callable)
+{
+    if (mode == "21")
+    {
+        return callable(TableMode::Table21());
+    }
+    if (mode == "3")
+    {
+        return callable(TableMode::Table3());
+    }
+    if (mode == "21t")
+    {
+        return callable(TableMode::Table21t());
+    }
+    std::string msg = Form("unknown table mode : %s, expect 21, 3 or 21t", mode.c_str());
+    throw std::invalid_argument(msg.c_str());
+}
+
+/**
+ * @brief Columnar store of complete events, used to hand parsed events from the reader threads to the tree or to the filter.
+ *
+ * Only the columns of the table mode are kept.
+ */
+template <typename Mode>
+class EventBuffer
+{
+public:
+    std::size_t Size() const { return multi.size(); }
+
+    void Push(const AMD &event)
+    {
+        multi.push_back(event.multi);
+        b.push_back(event.b);
+        N.insert(N.end(), event.N.begin(), event.N.begin() + event.multi);
+        Z.insert(Z.end(), event.Z.begin(), event.Z.begin() + event.multi);
+        px.insert(px.end(), event.px.begin(), event.px.begin() + event.multi);
+        py.insert(py.end(), event.py.begin(), event.py.begin() + event.multi);
+        pz.insert(pz.end(), event.pz.begin(), event.pz.begin() + event.multi);
+        if constexpr (Mode::has_table21)
+        {
+            ENG.insert(ENG.end(), event.ENG.begin(), event.ENG.begin() + event.multi);
+            LANG.insert(LANG.end(), event.LANG.begin(), event.LANG.begin() + event.multi);
+            JX.insert(JX.end(), event.JX.begin(), event.JX.begin() + event.multi);
+            JY.insert(JY.end(), event.JY.begin(), event.JY.begin() + event.multi);
+            JZ.insert(JZ.end(), event.JZ.begin(), event.JZ.begin() + event.multi);
+        }
+        if constexpr (Mode::has_table3)
+        {
+            J.insert(J.end(), event.J.begin(), event.J.begin() + event.multi);
+            M.insert(M.end(), event.M.begin(), event.M.begin() + event.multi);
+            WEIGHT.insert(WEIGHT.end(), event.WEIGHT.begin(), event.WEIGHT.begin() + event.multi);
+            iFRG.insert(iFRG.end(), event.iFRG.begin(), event.iFRG.begin() + event.multi);
+        }
+    }
+
+    // events must be loaded in order, the particle offset is carried from one call to the next
+    void Load(const std::size_t &ievt, AMD &event)
+    {
+        if (ievt == 0)
+        {
+            offset = 0;
+        }
+        event.multi = multi[ievt];
+        event.b = b[ievt];
+
+        auto copy = [this, &event](const auto &column, auto &array)
+        {
+            std::copy(column.begin() + this->offset, column.begin() + this->offset + event.multi, array.begin());
+        };
+        copy(N, event.N);
+        copy(Z, event.Z);
+        copy(px, event.px);
+        copy(py, event.py);
+        copy(pz, event.pz);
+        if constexpr (Mode::has_table21)
+        {
+            copy(ENG, event.ENG);
+            copy(LANG, event.LANG);
+            copy(JX, event.JX);
+            copy(JY, event.JY);
+            copy(JZ, event.JZ);
+        }
+        if constexpr (Mode::has_table3)
+        {
+            copy(J, event.J);
+            copy(M, event.M);
+            copy(WEIGHT, event.WEIGHT);
+            copy(iFRG, event.iFRG);
+        }
+        offset += event.multi;
+    }
+
+private:
+    std::size_t offset = 0;
+
+    std::vector<int> multi;
+    std::vector<double> b;
+    std::vector<int> N, Z, iFRG;
+    std::vector<double> px, py, pz;
+    std::vector<double> ENG, LANG, JX, JY, JZ;
+    std::vector<double> J, M, WEIGHT;
+};
+
+std::pair<const char *, const char *> GetTableRange(const MappedFile &file, const long &offset, const bool &has_header);
+// hash of the first and the last 64 kB of the table before offset, to recognize the input of a checkpoint
+long GetTableHash(const MappedFile &file, const long &offset);
+
+/**
+ * @brief Throw for a row of the table at pos that cannot be parsed, with its byte offset from origin, the start of the file.
+ */
+[[noreturn]] inline void ThrowParseError(const char *pos, const char *origin, const std::string &what)
+{
+    std::string msg = Form("cannot parse the AMD table at byte %ld : %s", static_cast<long>(pos - origin), what.c_str());
+    throw std::invalid_argument(msg.c_str());
+}
+
+/**
+ * @brief Parse particles until the tokenizer is exhausted, calling fill() whenever the nucleons add up to amass.
+ *
+ * Throws on a token that is not a number or an event of more than AMD::MAX_MULTI particles, with the byte offset from origin.
+ *
+ * @return false if parsing stopped on a `0 0` record, true at the end of the range
+ */
+template <typename Mode, typename Callback>
+bool ParseEvents(Tokenizer &tokens, AMD &event, const int &amass, Callback fill, const char *origin)
+{
+    int eventID;
+    int nucleons_count = 0;
+    int multi = 0;
+    TableMode::Row row;
+    while ((row = Mode::ReadRow(tokens, event, multi, eventID)) == TableMode::Particle)
+    {
+        nucleons_count += event.Z[multi] + event.N[multi];
+        multi++;
+        if (nucleons_count == amass)
+        {
+            event.multi = multi;
+            fill();
+            multi = 0;
+            nucleons_count = 0;
+        }
+        else if (multi == AMD::MAX_MULTI)
+        {
+            ThrowParseError(tokens.Position(), origin, Form("more than %d particles without reaching A = %d", AMD::MAX_MULTI, amass));
+        }
+    }
+    if (row == TableMode::Invalid)
+    {
+        ThrowParseError(tokens.Position(), origin, "not a number or out of range");
+    }
+    return row == TableMode::End;
+}
+
+#endif
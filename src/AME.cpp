@@ -1,52 +1,183 @@
 #include "AME.hh"
 
+#include <vector>
+#include <limits>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "TString.h"
+#include "MappedFile.hh"
+
 AME::AME(const std::string &filename)
 {
-    this->ReadAMETable(filename);
+    // read on first use, see GetMassTable()
+    this->mPath = filename;
 }
 
-void AME::ReadAMETable(const std::string &filename)
+void AME::Load()
 {
+    if (this->mMass == nullptr)
+    {
+        this->ReadAMETable(this->mPath);
+    }
+}
 
+void AME::ReadAMETable(const std::string &filename)
+{
+    this->mPath = filename;
     std::string path = filename;
-    fs::path PROJECT_DIR = std::getenv("PROJECT_DIR");
-    fs::path default_path = PROJECT_DIR / DefaultPath;
-
     if (path.empty())
     {
-        path = default_path;
+        if (std::getenv("PROJECT_DIR") == nullptr)
+        {
+            std::string msg = Form("PROJECT_DIR is not set, cannot read %s for the masses beyond Z = %d.", DefaultPath.c_str(), AMELight::NZ - 1);
+            throw std::invalid_argument(msg.c_str());
+        }
+        fs::path PROJECT_DIR = std::getenv("PROJECT_DIR");
+        path = PROJECT_DIR / DefaultPath;
     }
 
-    MassTable.clear();
-    ZATable.clear();
+    this->mOwner.reset();
+    this->mMass = nullptr;
+    this->mSymbols = nullptr;
+    this->mNZ = this->mNA = 0;
+    this->mNSymbols = 0;
+    if (!fs::exists(path))
+    {
+        return;
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.source_size = fs::file_size(path);
+    header.source_mtime = fs::last_write_time(path).time_since_epoch().count();
+    fs::path path_snapshot = fs::path(path).replace_extension(".bin");
+    if (this->ReadSnapshot(path_snapshot, header))
+    {
+        return;
+    }
 
     std::ifstream infile(path.c_str());
     infile.ignore(99, '\n');
 
+    std::map<std::pair<int, int>, double> MassTable;
+    std::vector<Symbol> symbols;
     std::string symbol;
     int Z, A;
     double mass;                       // MeV/c^2
     double binding_enregy_per_nucleon; // MeV
     while (infile >> symbol >> Z >> A >> mass >> binding_enregy_per_nucleon)
     {
-        std::pair pair = std::make_pair(Z, A);
-        MassTable[pair] = mass;
-        ZATable[symbol] = pair;
+        MassTable[{Z, A}] = mass;
+        Symbol entry;
+        std::memset(&entry, 0, sizeof(entry));
+        std::strncpy(entry.name, symbol.c_str(), sizeof(entry.name) - 1);
+        entry.Z = Z;
+        entry.A = A;
+        symbols.push_back(entry);
+    }
+    std::stable_sort(symbols.begin(), symbols.end(), [](const Symbol &a, const Symbol &b)
+                     { return std::strcmp(a.name, b.name) < 0; });
+
+    for (const auto &[ZA, mass] : MassTable)
+    {
+        header.nz = std::max<uint32_t>(header.nz, ZA.first + 1);
+        header.na = std::max<uint32_t>(header.na, ZA.second + 1);
+    }
+    header.nsymbols = symbols.size();
+
+    // the snapshot image, also used directly if it cannot be written
+    std::size_t mass_bytes = sizeof(double) * header.nz * header.na;
+    auto image = std::make_shared<std::vector<char>>(sizeof(Header) + mass_bytes + sizeof(Symbol) * symbols.size());
+    char *data = image->data();
+    std::memcpy(data, &header, sizeof(Header));
+    double *masses = reinterpret_cast<double *>(data + sizeof(Header));
+    for (int z = 0; z < static_cast<int>(header.nz); z++)
+    {
+        for (int a = 0; a < static_cast<int>(header.na); a++)
+        {
+            auto found = MassTable.find({z, a});
+            // NaN for Z > A, which GetMass() leaves to _GetMassUnphysical() to report
+            masses[z * header.na + a] = (found != MassTable.end()) ? found->second : (z > a) ? std::numeric_limits<double>::quiet_NaN() : this->_GetMassUnphysical(z, a);
+        }
+    }
+    std::memcpy(data + sizeof(Header) + mass_bytes, symbols.data(), sizeof(Symbol) * symbols.size());
+    header.checksum = Checksum(data + sizeof(Header), image->size() - sizeof(Header));
+    std::memcpy(data, &header, sizeof(Header));
+    this->Attach(image, data);
+
+    // written to a unique file next to the target and renamed, so that a reader never maps a partial snapshot;
+    // a read-only database only loses the cache
+    std::string tmp = path_snapshot.string() + ".XXXXXX";
+    int descriptor = mkstemp(tmp.data());
+    if (descriptor < 0)
+    {
+        return;
+    }
+    fchmod(descriptor, 0644);
+    std::FILE *out = fdopen(descriptor, "wb");
+    if (out == nullptr)
+    {
+        close(descriptor);
+        std::remove(tmp.c_str());
+        return;
+    }
+    bool written = std::fwrite(data, 1, image->size(), out) == image->size();
+    written &= std::fclose(out) == 0;
+    if (!written || std::rename(tmp.c_str(), path_snapshot.c_str()) != 0)
+    {
+        std::remove(tmp.c_str());
     }
 }
 
-double AME::GetMass(const int &Z, const int &A)
+bool AME::ReadSnapshot(const fs::path &path, const Header &expected)
 {
-    if (this->MassTable.size() == 0)
+    if (!fs::exists(path))
+    {
+        return false;
+    }
+    auto file = std::make_shared<MappedFile>(path.string());
+    if (file->Size() < sizeof(Header))
     {
-        this->ReadAMETable();
+        return false;
     }
+    Header header;
+    std::memcpy(&header, file->Begin(), sizeof(Header));
+    bool valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.source_size == expected.source_size && header.source_mtime == expected.source_mtime;
+    valid &= file->Size() == sizeof(Header) + sizeof(double) * header.nz * header.na + sizeof(Symbol) * header.nsymbols;
+    valid = valid && header.checksum == Checksum(file->Begin() + sizeof(Header), file->Size() - sizeof(Header));
+    if (!valid)
+    {
+        return false;
+    }
+    this->Attach(file, file->Begin());
+    return true;
+}
 
-    if (this->MassTable.count({Z, A}) == 0)
+uint64_t AME::Checksum(const char *data, const std::size_t &size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; i++)
     {
-        return this->_GetMassUnphysical(Z, A);
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
     }
-    return this->MassTable[{Z, A}];
+    return hash;
+}
+
+void AME::Attach(const std::shared_ptr<const void> &owner, const char *image)
+{
+    Header header;
+    std::memcpy(&header, image, sizeof(Header));
+    this->mOwner = owner;
+    this->mNZ = header.nz;
+    this->mNA = header.na;
+    this->mNSymbols = header.nsymbols;
+    this->mMass = reinterpret_cast<const double *>(image + sizeof(Header));
+    this->mSymbols = reinterpret_cast<const Symbol *>(image + sizeof(Header) + sizeof(double) * header.nz * header.na);
 }
 
 double AME::_GetMassUnphysical(const int &Z, const int &A)
@@ -65,16 +196,17 @@ double AME::_GetMassUnphysical(const int &Z, const int &A)
 
 double AME::GetMass(const std::string &symbol)
 {
-    if (this->ZATable.size() == 0)
+    if (this->mSymbols == nullptr)
     {
-        this->ReadAMETable();
+        this->ReadAMETable(this->mPath);
     }
 
-    if (this->ZATable.count(symbol) == 0)
+    const Symbol *end = this->mSymbols + this->mNSymbols;
+    const Symbol *found = std::lower_bound(this->mSymbols, end, symbol, [](const Symbol &entry, const std::string &name)
+                                           { return std::strcmp(entry.name, name.c_str()) < 0; });
+    if (found == end || symbol != found->name)
     {
         throw std::invalid_argument("Symbol is not valid!");
     }
-
-    std::pair<int, int> ZA = this->ZATable[symbol];
-    return this->GetMass(ZA.first, ZA.second);
-}
\ No newline at end of file
+    return this->GetMass(found->Z, found->A);
+}
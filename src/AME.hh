@@ -2,31 +2,131 @@
 #define AME_hh
 
 #include <map>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
 #include <string>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
 namespace fs = std::filesystem;
 
+#include "AMELight.hh"
+
+/**
+ * @brief Nuclear masses of the Atomic Mass Evaluation, as a dense [Z][A] array.
+ *
+ * With the default table, the nuclei up to Z = 28 are compiled in (AMELight.hh, generated by the
+ * makefiles), so that light fragments need neither a file nor PROJECT_DIR; another table is always read.
+ * The text table is read on first use, or by Load(), and cached as a memory-mapped binary snapshot next
+ * to it (`ame_mass.bin`). Copies of an AME share the array.
+ */
 class AME
 {
 public:
     AME(const std::string &filename = "");
     ~AME() { ; }
 
+    // the table used from now on, also for the nuclei up to Z = 28 if it is not the default
     void ReadAMETable(const std::string &filename = "");
+    // read the table of the constructor now, e.g. before copies are handed to threads
+    void Load();
 
     double GetMass(const std::string &symbol);
     double GetMass(const int &Z, const int &A);
     double _GetMassUnphysical(const int &Z, const int &A);
 
+    static constexpr double NucleonMass = 938.272;
+
+    static constexpr char MAGIC[8] = {'A', 'M', 'E', 'B', 'I', 'N', '0', '2'};
+
+    // layout of the snapshot (native endianness) : Header, float64 mass[nz][na], Symbol[nsymbols] sorted by name
+    struct Header
+    {
+        char magic[8];
+        uint32_t nz, na;
+        uint64_t nsymbols;
+        // size and modification time of the text table the snapshot was built from
+        int64_t source_size, source_mtime;
+        // FNV-1a of everything after the header
+        uint64_t checksum;
+    };
+    struct Symbol
+    {
+        char name[12];
+        int32_t Z, A;
+    };
+
 private:
-    std::map<std::pair<int, int>, double> MassTable;
-    std::map<std::string, std::pair<int, int>> ZATable;
+    // point the lookups into a snapshot image held by owner
+    void Attach(const std::shared_ptr<const void> &owner, const char *image);
+    bool ReadSnapshot(const fs::path &path, const Header &expected);
+    static uint64_t Checksum(const char *data, const std::size_t &size);
+    // mass of the text table, read on first use
+    double GetMassTable(const int &Z, const int &A);
+
+    std::string mPath;
+
+    std::shared_ptr<const void> mOwner;
+    const double *mMass = nullptr;
+    const Symbol *mSymbols = nullptr;
+    unsigned int mNZ = 0, mNA = 0;
+    std::size_t mNSymbols = 0;
 
 protected:
-    double NucleonMass = 938.272;
     fs::path DefaultPath = "database/ame/ame_mass.txt";
 };
 
-#endif
\ No newline at end of file
+namespace AMELight
+{
+    // AMELight::TABLE on a dense [Z][A] array with the fallback of AME::_GetMassUnphysical(), NaN where Z > A
+    constexpr std::array<double, NZ * NA> BuildMass()
+    {
+        std::array<double, NZ * NA> mass = {};
+        for (int Z = 0; Z < NZ; Z++)
+        {
+            for (int A = 0; A < NA; A++)
+            {
+                mass[Z * NA + A] = (Z > A) ? std::numeric_limits<double>::quiet_NaN() : (Z > 0) ? A * AME::NucleonMass : -1e10;
+            }
+        }
+        for (const auto &entry : TABLE)
+        {
+            mass[entry.Z * NA + entry.A] = entry.mass;
+        }
+        return mass;
+    }
+    inline constexpr std::array<double, NZ * NA> MASS = BuildMass();
+}
+
+inline double AME::GetMass(const int &Z, const int &A)
+{
+    // the compiled-in masses are those of the default table; negative Z or A wrap around and fall outside as well
+    if (this->mPath.empty() && static_cast<unsigned int>(Z) < AMELight::NZ && static_cast<unsigned int>(A) < AMELight::NA)
+    {
+        double mass = AMELight::MASS[Z * AMELight::NA + A];
+        return std::isnan(mass) ? this->_GetMassUnphysical(Z, A) : mass;
+    }
+    return this->GetMassTable(Z, A);
+}
+
+inline double AME::GetMassTable(const int &Z, const int &A)
+{
+    if (this->mMass == nullptr)
+    {
+        this->ReadAMETable(this->mPath);
+    }
+    if (static_cast<unsigned int>(Z) < this->mNZ && static_cast<unsigned int>(A) < this->mNA)
+    {
+        double mass = this->mMass[Z * this->mNA + A];
+        if (!std::isnan(mass))
+        {
+            return mass;
+        }
+    }
+    return this->_GetMassUnphysical(Z, A);
+}
+
+#endif
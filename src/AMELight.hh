@@ -0,0 +1,665 @@
+// generated by database/ame/embed_ame_mass.awk from database/ame/ame_mass.txt, do not edit
+#ifndef AMELight_hh
+#define AMELight_hh
+
+#include <array>
+
+/**
+ * @brief Masses of the nuclei up to Z = 28 of the Atomic Mass Evaluation (MeV/c^2), compiled in for the hot loops, see AME::GetMass().
+ */
+namespace AMELight
+{
+    struct Entry
+    {
+        int Z, A;
+        double mass;
+    };
+
+    constexpr int NZ = 29;
+    constexpr int NA = 83;
+    constexpr std::array<Entry, 641> TABLE = {{
+        {0, 1, 939.5654204759348}, // n1
+        {1, 1, 938.7830734813573}, // h1
+        {1, 2, 1876.1239277295713}, // h2
+        {1, 3, 2809.4321181490463}, // h3
+        {2, 3, 2809.4135261322335}, // he3
+        {3, 3, 2823.1490382533207}, // li3
+        {1, 4, 3750.597537894952}, // h4
+        {2, 4, 3728.4013255377654}, // he4
+        {3, 4, 3751.2995994109783}, // li4
+        {1, 5, 4690.362958631272}, // h5
+        {2, 5, 4668.701745133244}, // he5
+        {3, 5, 4669.149398843007}, // li5
+        {4, 5, 4694.609181949093}, // be5
+        {1, 6, 5630.840338939951}, // h6
+        {2, 6, 5606.55670872527}, // he6
+        {3, 6, 5603.051494946114}, // li6
+        {4, 6, 5607.339648148235}, // be6
+        {5, 6, 5636.284514905657}, // b6
+        {1, 7, 6569.594099328412}, // h7
+        {2, 7, 6546.53184418082}, // he7
+        {3, 7, 6535.365821551621}, // li7
+        {4, 7, 6536.227714172516}, // be7
+        {5, 7, 6548.135269691028}, // b7
+        {2, 8, 7483.56250162829}, // he8
+        {3, 8, 7472.898623008667}, // li8
+        {4, 8, 7456.894490562875}, // be8
+        {5, 8, 7474.874388135976}, // b8
+        {6, 8, 7487.017088162714}, // c8
+        {2, 9, 8424.382747217682}, // he9
+        {3, 9, 8408.401826673427}, // li9
+        {4, 9, 8394.795372156681}, // be9
+        {5, 9, 8395.863407459114}, // b9
+        {6, 9, 8412.35789237283}, // c9
+        {2, 10, 9364.1381702278}, // he10
+        {3, 10, 9347.993651374338}, // li10
+        {4, 10, 9327.548509947475}, // be10
+        {5, 10, 9326.991634828228}, // b10
+        {6, 10, 9330.639696413698}, // c10
+        {7, 10, 9353.74105102624}, // n10
+        {3, 11, 10287.163384426645}, // li11
+        {4, 11, 10266.612294860573}, // be11
+        {5, 11, 10255.1028338396}, // b11
+        {6, 11, 10257.0845232694}, // c11
+        {7, 11, 10270.800770201517}, // n11
+        {8, 11, 10294.17403912048}, // o11
+        {3, 12, 11226.93880568365}, // li12
+        {4, 12, 11203.006989613523}, // be12
+        {5, 12, 11191.29862665686}, // b12
+        {6, 12, 11177.929229005731}, // c12
+        {7, 12, 11195.267296402959}, // n12
+        {8, 12, 11209.94256308822}, // o12
+        {3, 13, 12166.404225703369}, // li13
+        {4, 13, 12143.082410655632}, // be13
+        {5, 13, 12125.985278865464}, // b13
+        {6, 13, 12112.548340756666}, // c13
+        {7, 13, 12114.768811862454}, // n13
+        {8, 13, 12132.538762774293}, // o13
+        {9, 13, 12151.45327681804}, // f13
+        {4, 14, 13080.87193585547}, // be14
+        {5, 14, 13064.581119332766}, // b14
+        {6, 14, 13043.937327119653}, // c14
+        {7, 14, 13043.7808506697}, // n14
+        {8, 14, 13048.925214779234}, // o14
+        {9, 14, 13072.881836537308}, // f14
+        {4, 15, 14022.23735606669}, // be15
+        {5, 15, 14001.36891484337}, // b15
+        {6, 15, 13982.284680711175}, // c15
+        {7, 15, 13972.512974353433}, // n15
+        {8, 15, 13975.267158111323}, // o15
+        {9, 15, 13988.978288346334}, // f15
+        {10, 15, 14012.626909716455}, // ne15
+        {4, 16, 14961.352776492367}, // be16
+        {5, 16, 14941.017337125944}, // b16
+        {6, 16, 14917.599771004938}, // c16
+        {7, 16, 14909.5895458252}, // n16
+        {8, 16, 15830.662738923598}, // o16
+        {9, 16, 14914.580820043371}, // f16
+        {10, 16, 14927.892412896477}, // ne16
+        {5, 17, 15879.11606247814}, // b17
+        {6, 17, 15856.431620406993}, // c17
+        {7, 17, 15843.269819257506}, // n17
+        {8, 17, 16766.085079296565}, // o17
+        {9, 17, 15837.351442000117}, // f17
+        {10, 17, 15851.900192224894}, // ne17
+        {11, 17, 15870.119320770846}, // na17
+        {5, 18, 16818.686483307563}, // b18
+        {6, 18, 16791.813108531875}, // c18
+        {7, 18, 16780.007010419504}, // n18
+        {8, 18, 17697.60512959041}, // o18
+        {9, 18, 16767.76695528665}, // f18
+        {10, 18, 16772.21146016509}, // ne18
+        {11, 18, 16791.93183490718}, // na18
+        {5, 19, 17758.15819650144}, // b19
+        {6, 19, 17730.801699515046}, // c19
+        {7, 19, 17714.244200888294}, // n19
+        {8, 19, 17701.72080294787}, // o19
+        {9, 19, 18628.394603228575}, // f19
+        {10, 19, 17700.13999877194}, // ne19
+        {11, 19, 17711.317329981735}, // na19
+        {12, 19, 17730.22633982683}, // mg19
+        {5, 20, 18699.283616325676}, // b20
+        {6, 20, 18667.385614253988}, // c20
+        {7, 20, 18651.648545824828}, // n20
+        {8, 20, 18633.67821935363}, // o20
+        {9, 20, 19561.3586871086}, // f20
+        {10, 20, 19554.3342185901}, // ne20
+        {11, 20, 18636.732536351785}, // na20
+        {12, 20, 18647.359742048597}, // mg20
+        {5, 21, 19639.759036770763}, // b21
+        {6, 21, 19607.019361778468}, // c21
+        {7, 21, 19586.608065258322}, // n21
+        {8, 21, 19569.43818377876}, // o21
+        {9, 21, 20492.822647308083}, // f21
+        {10, 21, 20487.13847654436}, // ne21
+        {11, 21, 20490.685395568697}, // na21
+        {12, 21, 19572.280000890314}, // mg21
+        {13, 21, 19588.465862246525}, // al21
+        {6, 22, 20546.48145543275}, // c22
+        {7, 22, 20524.635057181185}, // n22
+        {8, 22, 20502.153284939373}, // o22
+        {9, 22, 20495.66362886943}, // f22
+        {10, 22, 21416.33963916083}, // ne22
+        {11, 22, 21419.18296342985}, // na22
+        {12, 22, 21423.96436923226}, // mg22
+        {13, 22, 20511.071647938406}, // al22
+        {14, 22, 20526.510231191867}, // si22
+        {6, 23, 21488.534984309834}, // c23
+        {7, 23, 21461.084784605704}, // n23
+        {8, 23, 21438.985726030813}, // o23
+        {9, 23, 21427.64961885678}, // f23
+        {10, 23, 22350.704412650848}, // ne23
+        {11, 23, 22346.328604484395}, // na23
+        {12, 23, 22350.38478255903}, // mg23
+        {13, 23, 21431.112425826657}, // al23
+        {14, 23, 21448.314000461567}, // si23
+        {7, 24, 22402.796445832264}, // n24
+        {8, 24, 22374.35886237957}, // o24
+        {9, 24, 22363.402973399756}, // f24
+        {10, 24, 23281.400917653835}, // ne24
+        {11, 24, 23278.934659402996}, // na24
+        {12, 24, 23273.418981949984}, // mg24
+        {13, 24, 23287.30374827465}, // al24
+        {14, 24, 22366.603643025308}, // si24
+        {15, 24, 22389.87848561994}, // p24
+        {7, 25, 23343.335355983876}, // n25
+        {8, 25, 23314.681590448403}, // o25
+        {9, 25, 23298.68672636893}, // f25
+        {10, 25, 24216.811159138666}, // ne25
+        {11, 25, 24209.48884887402}, // na25
+        {12, 25, 24205.65388020242}, // mg25
+        {13, 25, 24209.930688197597}, // al25
+        {14, 25, 23291.17988153363}, // si25
+        {15, 25, 23307.5426950985}, // p25
+        {8, 26, 24253.50770277828}, // o26
+        {9, 26, 24237.521317158127}, // f26
+        {10, 26, 24219.327775823673}, // ne26
+        {11, 26, 25143.479984244164}, // na26
+        {12, 26, 25134.126221340284}, // mg26
+        {13, 26, 25138.130625063146}, // al26
+        {14, 26, 25143.19976194184}, // si26
+        {15, 26, 24229.819663372225}, // p26
+        {16, 26, 24246.52694159318}, // s26
+        {8, 27, 25195.01056494431}, // o27
+        {9, 27, 25175.474243190423}, // f27
+        {10, 27, 25157.391674474366}, // ne27
+        {11, 27, 26076.317076666917}, // na27
+        {12, 27, 26067.24827271287}, // mg27
+        {13, 27, 26064.638003610806}, // al27
+        {14, 27, 26069.45036203075}, // si27
+        {15, 27, 26081.175834671085}, // p27
+        {16, 27, 25167.831430023984}, // s27
+        {8, 28, 26133.914702946182}, // o28
+        {9, 28, 26115.238663502078}, // f28
+        {10, 28, 26093.134605598334}, // ne28
+        {11, 28, 27012.34065485452}, // na28
+        {12, 28, 26998.309024512197}, // mg28
+        {13, 28, 26996.478250167904}, // al28
+        {14, 28, 26991.83617298709}, // si28
+        {15, 28, 27006.18111284252}, // p28
+        {16, 28, 26085.908069694313}, // s28
+        {17, 28, 26110.1047821943}, // cl28
+        {9, 29, 27053.47916039367}, // f29
+        {10, 29, 27031.728773102233}, // ne29
+        {11, 29, 27016.0089633958}, // na29
+        {12, 29, 27934.21071203903}, // mg29
+        {13, 29, 27926.615310059413}, // al29
+        {14, 29, 27922.9279909717}, // si29
+        {15, 29, 27927.870222640166}, // p29
+        {16, 29, 27941.7286491061}, // s29
+        {17, 29, 27027.35075082087}, // cl29
+        {18, 29, 27051.29760120581}, // ar29
+        {9, 30, 27993.783334031476}, // f30
+        {10, 30, 27968.103192023053}, // ne30
+        {11, 30, 27953.297741585026}, // na30
+        {12, 30, 28867.435801563246}, // mg30
+        {13, 30, 28860.4530581587}, // al30
+        {14, 30, 28851.884212239762}, // si30
+        {15, 30, 28856.116318764463}, // p30
+        {16, 30, 28862.257920200045}, // s30
+        {17, 30, 27949.49762010779}, // cl30
+        {18, 30, 27966.893893777}, // ar30
+        {9, 31, 28933.159739543273}, // f31
+        {10, 31, 28907.49876861497}, // ne31
+        {11, 31, 28888.56320559899}, // na31
+        {12, 31, 29804.689125223944}, // mg31
+        {13, 31, 29792.860567857275}, // al31
+        {14, 31, 29784.86223972021}, // si31
+        {15, 31, 29783.37073292833}, // p31
+        {16, 31, 29788.76874527589}, // s31
+        {17, 31, 29800.776724242092}, // cl31
+        {18, 31, 28887.64228022866}, // ar31
+        {19, 31, 28910.577528018377}, // k31
+        {10, 32, 29844.81022309663}, // ne32
+        {11, 32, 29826.451428187946}, // na32
+        {12, 32, 30738.476478560795}, // mg32
+        {13, 32, 30728.206010886366}, // al32
+        {14, 32, 30715.22768985621}, // si32
+        {15, 32, 30715.000503102096}, // p32
+        {16, 32, 30713.289842630842}, // s32
+        {17, 32, 30725.970673749493}, // cl32
+        {18, 32, 30737.10502675289}, // ar32
+        {19, 32, 29829.801058624376}, // k32
+        {10, 33, 30785.435762199766}, // ne33
+        {11, 33, 30763.085492706366}, // na33
+        {12, 33, 30744.268251797257}, // mg33
+        {13, 33, 31662.302099560016}, // al33
+        {14, 33, 31650.285154031586}, // si33
+        {15, 33, 31644.46213103098}, // p33
+        {16, 33, 31644.213623885888}, // s33
+        {17, 33, 31649.796141983672}, // cl33
+        {18, 33, 31661.415186765338}, // ar33
+        {19, 33, 30746.845824524826}, // k33
+        {20, 33, 30770.335311305484}, // ca33
+        {10, 34, 31723.641279624826}, // ne34
+        {11, 34, 31702.479596606114}, // na34
+        {12, 34, 31679.12280581782}, // mg34
+        {13, 34, 32599.295965784917}, // al34
+        {14, 34, 32582.30190009121}, // si34
+        {15, 34, 32577.74488283462}, // p34
+        {16, 34, 32572.36189485352}, // s34
+        {17, 34, 32577.853498772936}, // cl34
+        {18, 34, 32583.915291656816}, // ar34
+        {19, 34, 32601.07332732589}, // k34
+        {20, 34, 31685.689415410045}, // ca34
+        {11, 35, 32640.125286075618}, // na35
+        {12, 35, 32617.933370579634}, // mg35
+        {13, 35, 33533.5639570377}, // al35
+        {14, 35, 33519.39620653069}, // si35
+        {15, 35, 33508.92987731733}, // p35
+        {16, 35, 33504.941476663145}, // s35
+        {17, 35, 33504.77415517201}, // cl35
+        {18, 35, 33510.74039818534}, // ar35
+        {19, 35, 33522.614793445304}, // k35
+        {20, 35, 32607.48386973872}, // ca35
+        {21, 35, 32629.393542521677}, // sc35
+        {11, 36, 33579.690784890205}, // na36
+        {12, 36, 33554.16784648398}, // mg36
+        {13, 36, 33539.73807134344}, // al36
+        {14, 36, 34452.84566410787}, // si36
+        {15, 36, 34445.03074436509}, // p36
+        {16, 36, 34434.61764817669}, // s36
+        {17, 36, 34435.759781040484}, // cl36
+        {18, 36, 34435.05024707877}, // ar36
+        {19, 36, 34447.86460744851}, // k36
+        {20, 36, 34458.830622700705}, // ca36
+        {21, 36, 33549.93793176491}, // sc36
+        {11, 37, 34518.41607602442}, // na37
+        {12, 37, 34493.49326666608}, // mg37
+        {13, 37, 34475.091353826894}, // al37
+        {14, 37, 35390.2043788743}, // si37
+        {15, 37, 35377.77987859423}, // p37
+        {16, 37, 35369.87946539124}, // s37
+        {17, 37, 35365.014339693385}, // cl37
+        {18, 37, 35365.828212172506}, // ar37
+        {19, 37, 35371.975690404375}, // k37
+        {20, 37, 35383.639821363584}, // ca37
+        {21, 37, 34469.06179250195}, // sc37
+        {22, 37, 34490.45169157575}, // ti37
+        {11, 38, 35458.68112690992}, // na38
+        {12, 38, 35430.8499461179}, // mg38
+        {13, 38, 35413.245639076325}, // al38
+        {14, 38, 36324.0996951721}, // si38
+        {15, 38, 36313.64842914987}, // p38
+        {16, 38, 36301.408778285455}, // s38
+        {17, 38, 36298.471877981894}, // cl38
+        {18, 38, 36293.55516707214}, // ar38
+        {19, 38, 36299.469234306314}, // k38
+        {20, 38, 36306.21149015247}, // ca38
+        {21, 38, 36324.0205181734}, // sc38
+        {22, 38, 35408.14570886559}, // ti38
+        {11, 39, 36398.24662572451}, // na39
+        {12, 39, 36371.04513494572}, // mg39
+        {13, 39, 36349.75956321139}, // al39
+        {14, 39, 36330.59034607775}, // si39
+        {15, 39, 37246.98946081352}, // p39
+        {16, 39, 37236.60142461095}, // s39
+        {17, 39, 37229.96387801685}, // cl39
+        {18, 39, 37226.52190111809}, // ar39
+        {19, 39, 37225.95690133962}, // k39
+        {20, 39, 37232.48138986769}, // ca39
+        {21, 39, 37245.59137013727}, // sc39
+        {22, 39, 36330.770124439514}, // ti39
+        {23, 39, 36350.8400963702}, // v39
+        {12, 40, 37309.31399396975}, // mg40
+        {13, 40, 37288.58452421456}, // al40
+        {14, 40, 37265.43097239849}, // si40
+        {15, 40, 38183.11900949619}, // p40
+        {16, 40, 38168.420349268046}, // s40
+        {17, 40, 38163.700380159156}, // cl40
+        {18, 40, 38156.21829913183}, // ar40
+        {19, 40, 38157.72270212422}, // k40
+        {20, 40, 38156.411796501474}, // ca40
+        {21, 40, 38170.734845705236}, // sc40
+        {22, 40, 38182.26475954222}, // ti40
+        {23, 40, 37272.23400823483}, // v40
+        {12, 41, 38249.35828075298}, // mg41
+        {13, 41, 38225.84830110207}, // al41
+        {14, 41, 38204.458402028264}, // si41
+        {15, 41, 39117.772534048534}, // p41
+        {16, 41, 39103.743721475876}, // s41
+        {17, 41, 39095.445109448}, // cl41
+        {18, 41, 39089.68479183589}, // ar41
+        {19, 41, 39087.192752725234}, // k41
+        {20, 41, 39087.61439249674}, // ca41
+        {21, 41, 39094.109941198374}, // sc41
+        {22, 41, 39107.054762906126}, // ti41
+        {23, 41, 38191.56838663902}, // v41
+        {24, 41, 38211.66816638098}, // cr41
+        {13, 42, 39164.74219266882}, // al42
+        {14, 42, 39139.59185190356}, // si42
+        {15, 42, 39123.84414301727}, // p42
+        {16, 42, 40036.60865625735}, // s42
+        {17, 42, 40029.41463415497}, // cl42
+        {18, 42, 40019.82372589353}, // ar42
+        {19, 42, 40019.22437278023}, // k42
+        {20, 42, 40015.699110062276}, // ca42
+        {21, 42, 40022.125400314406}, // sc42
+        {22, 42, 40029.14205010429}, // ti42
+        {23, 42, 40046.62678217943}, // v42
+        {24, 42, 39129.81209532228}, // cr42
+        {13, 43, 40102.51642832446}, // al43
+        {14, 43, 40078.57609839824}, // si43
+        {15, 43, 40059.286718525385}, // p43
+        {16, 43, 40973.54504557016}, // s43
+        {17, 43, 40961.58099586583}, // cl43
+        {18, 43, 40953.73069518256}, // ar43
+        {19, 43, 40949.1651119062}, // k43
+        {20, 43, 40947.33163343453}, // ca43
+        {21, 43, 40949.55235636044}, // sc43
+        {22, 43, 40956.4249151906}, // ti43
+        {23, 43, 40967.82414878846}, // v43
+        {24, 43, 40983.77039632773}, // cr43
+        {25, 43, 40071.61597446498}, // mn43
+        {14, 44, 41015.05089978101}, // si44
+        {15, 44, 40996.85043651388}, // p44
+        {16, 44, 41908.03037209542}, // s44
+        {17, 44, 41896.755634547335}, // cl44
+        {18, 44, 41884.56134837721}, // ar44
+        {19, 44, 41881.45311091144}, // k44
+        {20, 44, 41875.7658783266}, // ca44
+        {21, 44, 41879.41857316374}, // sc44
+        {22, 44, 41879.686021887435}, // ti44
+        {23, 44, 41893.42652958345}, // v44
+        {24, 44, 41903.81271024977}, // cr44
+        {25, 44, 40993.20084262061}, // mn44
+        {14, 45, 41954.32484094154}, // si45
+        {15, 45, 41933.194828722306}, // p45
+        {16, 45, 42845.38837333737}, // s45
+        {17, 45, 42830.46616663407}, // cl45
+        {18, 45, 42818.95790910347}, // ar45
+        {19, 45, 42812.11306688032}, // k45
+        {20, 45, 42807.916480088745}, // ca45
+        {21, 45, 42807.65638923695}, // sc45
+        {22, 45, 42809.718444251936}, // ti45
+        {23, 45, 42816.84226895876}, // v45
+        {24, 45, 42829.213909743}, // cr45
+        {25, 45, 42843.74894371711}, // mn45
+        {26, 45, 41931.64202805358}, // fe45
+        {15, 46, 42871.56894657991}, // p46
+        {16, 46, 42849.368647637}, // s46
+        {17, 46, 43766.48786413508}, // cl46
+        {18, 46, 43750.45155788298}, // ar46
+        {19, 46, 43744.80888331854}, // k46
+        {20, 46, 43737.08320350525}, // ca46
+        {21, 46, 43738.46117018291}, // sc46
+        {22, 46, 43736.094543609775}, // ti46
+        {23, 46, 43743.14691619848}, // v46
+        {24, 46, 43750.75124282309}, // cr46
+        {25, 46, 43767.80506572646}, // mn46
+        {26, 46, 42849.93872202768}, // fe46
+        {15, 47, 43809.03299469944}, // p47
+        {16, 47, 43787.42326301747}, // s47
+        {17, 47, 44702.13649917956}, // cl47
+        {18, 47, 44686.349641459135}, // ar47
+        {19, 47, 44676.004933704746}, // k47
+        {20, 47, 44669.37225044136}, // ca47
+        {21, 47, 44667.38007331946}, // sc47
+        {22, 47, 44666.77930340362}, // ti47
+        {23, 47, 44669.709846259924}, // v47
+        {24, 47, 44677.15382269527}, // cr47
+        {25, 47, 44689.15053989777}, // mn47
+        {26, 47, 44704.587260163025}, // fe47
+        {27, 47, 43790.84277786744}, // co47
+        {16, 48, 44724.10671907917}, // s48
+        {17, 48, 45638.93080303946}, // cl48
+        {18, 48, 45620.856091476155}, // ar48
+        {19, 48, 45610.92653573931}, // k48
+        {20, 48, 45598.98615064265}, // ca48
+        {21, 48, 45598.706934353955}, // sc48
+        {22, 48, 45594.71806608974}, // ti48
+        {23, 48, 45598.73301339435}, // v48
+        {24, 48, 45600.389704531815}, // cr48
+        {25, 48, 45613.91437386636}, // mn48
+        {26, 48, 45625.202442958034}, // fe48
+        {27, 48, 44713.44670057111}, // co48
+        {28, 48, 44729.89502343159}, // ni48
+        {16, 49, 45663.60235583608}, // s49
+        {17, 49, 45643.95062475739}, // cl49
+        {18, 49, 46557.64480637144}, // ar49
+        {19, 49, 46545.09362475643}, // k49
+        {20, 49, 46533.40511752806}, // ca49
+        {21, 49, 46528.142673267255}, // sc49
+        {22, 49, 46526.14110854779}, // ti49
+        {23, 49, 46526.74296365426}, // v49
+        {24, 49, 46529.372768050634}, // cr49
+        {25, 49, 46537.08519456583}, // mn49
+        {26, 49, 46549.95439106189}, // fe49
+        {27, 49, 46564.925364275936}, // co49
+        {28, 49, 45651.740709935904}, // ni49
+        {17, 50, 46582.40485110779}, // cl50
+        {18, 50, 47492.969212537726}, // ar50
+        {19, 50, 47480.47137013801}, // k50
+        {20, 50, 47466.60999269876}, // ca50
+        {21, 50, 47461.66210281841}, // sc50
+        {22, 50, 47454.76735579873}, // ti50
+        {23, 50, 47456.97598327371}, // v50
+        {24, 50, 47455.9378591784}, // cr50
+        {25, 50, 47463.57233640412}, // mn50
+        {26, 50, 47471.7227635557}, // fe50
+        {27, 50, 47488.609820138416}, // co50
+        {28, 50, 47502.73965417798}, // ni50
+        {17, 51, 47520.489274299536}, // cl51
+        {18, 51, 48431.20360627996}, // ar51
+        {19, 51, 48415.17786875996}, // k51
+        {20, 51, 48401.36101580731}, // ca51
+        {21, 51, 48394.44297212013}, // sc51
+        {22, 51, 48387.96036000859}, // ti51
+        {23, 51, 48385.49022022183}, // v51
+        {24, 51, 48386.24261036421}, // cr51
+        {25, 51, 48389.45010038957}, // mn51
+        {26, 51, 48397.504140257406}, // fe51
+        {27, 51, 48410.35117930325}, // co51
+        {28, 51, 48426.04312895257}, // ni51
+        {17, 52, 48460.05291012592}, // cl52
+        {18, 52, 49367.80788534297}, // ar52
+        {19, 52, 49352.04979961238}, // k52
+        {20, 52, 49334.92115630822}, // ca52
+        {21, 52, 49328.66386703109}, // sc52
+        {22, 52, 49319.70973000106}, // ti52
+        {23, 52, 49317.7443957447}, // v52
+        {24, 52, 49313.767920078026}, // cr52
+        {25, 52, 49318.47604151343}, // mn52
+        {26, 52, 49320.85533268038}, // fe52
+        {27, 52, 49334.843449207205}, // co52
+        {28, 52, 49346.6275724422}, // ni52
+        {18, 53, 49375.97802011527}, // ar53
+        {19, 53, 50288.38580837389}, // k53
+        {20, 53, 50271.293823088636}, // ca53
+        {21, 53, 50261.911975637566}, // sc53
+        {22, 53, 50253.800097437925}, // ti53
+        {23, 53, 50248.829855425094}, // v53
+        {24, 53, 50245.39391274513}, // cr53
+        {25, 53, 50245.99118024314}, // mn53
+        {26, 53, 50249.73404650388}, // fe53
+        {27, 53, 50258.02215407276}, // co53
+        {28, 53, 50271.050703127905}, // ni53
+        {18, 54, 50313.24179700278}, // ar54
+        {19, 54, 51227.02540205067}, // k54
+        {20, 54, 51207.01504574255}, // ca54
+        {21, 54, 51197.73769888885}, // sc54
+        {22, 54, 51186.43182056144}, // ti54
+        {23, 54, 51182.2773652481}, // v54
+        {24, 54, 51175.240253327276}, // cr54
+        {25, 54, 51176.61738631771}, // mn54
+        {26, 54, 51175.921017162145}, // fe54
+        {27, 54, 51184.16556527231}, // co54
+        {28, 54, 51192.897321126315}, // ni54
+        {19, 55, 51232.646037464656}, // k55
+        {20, 55, 52145.01936044149}, // ca55
+        {21, 55, 52132.82762749669}, // sc55
+        {22, 55, 52121.83726671463}, // ti55
+        {23, 55, 52114.544599386805}, // v55
+        {24, 55, 52108.55941164641}, // cr55
+        {25, 55, 52105.957192516384}, // mn55
+        {26, 55, 52106.18831297009}, // fe55
+        {27, 55, 52109.63973894502}, // co55
+        {28, 55, 52118.33377394535}, // ni55
+        {19, 56, 52171.64984533549}, // k56
+        {20, 56, 53081.653447315766}, // ca56
+        {21, 56, 53069.64798897261}, // sc56
+        {22, 56, 53055.74084163914}, // ti56
+        {23, 56, 53048.9804365619}, // v56
+        {24, 56, 53039.8787098803}, // cr56
+        {25, 56, 53038.25217120693}, // mn56
+        {26, 56, 53034.55667421579}, // fe56
+        {27, 56, 53039.12331939541}, // co56
+        {28, 56, 53041.25618845505}, // ni56
+        {19, 57, 53109.29367181679}, // k57
+        {20, 57, 54020.09835872515}, // ca57
+        {21, 57, 54005.27828755569}, // sc57
+        {22, 57, 53992.25609129032}, // ti57
+        {23, 57, 53982.22287702677}, // v57
+        {24, 57, 53974.13295507461}, // cr57
+        {25, 57, 53969.17166099413}, // mn57
+        {26, 57, 53966.4759226507}, // fe57
+        {27, 57, 53967.312282328945}, // co57
+        {28, 57, 53970.573978790606}, // ni57
+        {19, 58, 54048.58810584757}, // k58
+        {20, 58, 54956.62159780124}, // ca58
+        {21, 58, 54942.672473617546}, // sc58
+        {22, 58, 54927.23437380952}, // ti58
+        {23, 58, 54917.72145861779}, // v58
+        {24, 58, 54906.16023446954}, // cr58
+        {25, 58, 54902.324474027955}, // mn58
+        {26, 58, 54895.99677124863}, // fe58
+        {27, 58, 54898.30475002159}, // co58
+        {28, 58, 54897.92317091449}, // ni58
+        {19, 59, 54986.90167658852}, // k59
+        {20, 59, 54963.961771328286}, // ca59
+        {21, 59, 55878.816594593955}, // sc59
+        {22, 59, 55863.7664443812}, // ti59
+        {23, 59, 55852.03552715784}, // v59
+        {24, 59, 55841.53021398479}, // cr59
+        {25, 59, 55834.120816473514}, // mn59
+        {26, 59, 55828.98118691563}, // fe59
+        {27, 59, 55827.416306631385}, // co59
+        {28, 59, 55828.489311454854}, // ni59
+        {20, 60, 55900.6461588841}, // ca60
+        {21, 60, 56816.58989875549}, // sc60
+        {22, 60, 56799.04054986595}, // ti60
+        {23, 60, 56788.052845705075}, // v60
+        {24, 60, 56774.231747002304}, // cr60
+        {25, 60, 56768.172301483566}, // mn60
+        {26, 60, 56759.72707321547}, // fe60
+        {27, 60, 56759.48980955816}, // co60
+        {28, 60, 56756.66700330974}, // ni60
+        {20, 61, 56840.150179087934}, // ca61
+        {21, 61, 56821.6404597788}, // sc61
+        {22, 61, 57736.26427250706}, // ti61
+        {23, 61, 57722.45722818732}, // v61
+        {24, 61, 57710.137847016704}, // cr61
+        {25, 61, 57700.892219400186}, // mn61
+        {26, 61, 57693.71384639873}, // fe61
+        {27, 61, 57689.73617096765}, // co61
+        {28, 61, 57688.41232037137}, // ni61
+        {21, 62, 57759.94471557872}, // sc62
+        {22, 62, 58671.92867402073}, // ti62
+        {23, 62, 58658.91528782659}, // v62
+        {24, 62, 58643.27584091085}, // cr62
+        {25, 62, 58635.604487696604}, // mn62
+        {26, 62, 58625.25039513913}, // fe62
+        {27, 62, 58622.70405261433}, // co62
+        {28, 62, 58617.38201229234}, // ni62
+        {21, 63, 58697.198246031105}, // sc63
+        {22, 63, 59609.76252529893}, // ti63
+        {23, 63, 59593.88241384092}, // v63
+        {24, 63, 59579.44425525345}, // cr63
+        {25, 63, 59568.735493522}, // mn63
+        {26, 63, 59559.98692513095}, // fe63
+        {27, 63, 59553.77100164392}, // co63
+        {28, 63, 59550.109662541516}, // ni63
+        {22, 64, 60545.63651298564}, // ti64
+        {23, 64, 60530.79688044003}, // v64
+        {24, 64, 60513.47667909969}, // cr64
+        {25, 64, 60504.12761651505}, // mn64
+        {26, 64, 60492.14710451545}, // fe64
+        {27, 64, 60487.324214623186}, // co64
+        {28, 64, 60480.01762332152}, // ni64
+        {22, 65, 60552.3265036292}, // ti65
+        {23, 65, 61466.50040470599}, // v65
+        {24, 65, 61450.30079077085}, // cr65
+        {25, 65, 61437.643415102204}, // mn65
+        {26, 65, 61427.39285718272}, // fe65
+        {27, 65, 61419.42555338822}, // co65
+        {28, 65, 61413.48496279098}, // ni65
+        {23, 66, 62403.805167334016}, // v66
+        {24, 66, 62384.964767618534}, // cr66
+        {25, 66, 62373.35446956648}, // mn66
+        {26, 66, 62360.03701482099}, // fe66
+        {27, 66, 62353.69632049343}, // co66
+        {28, 66, 62344.09856854482}, // ni66
+        {23, 67, 63339.85520740608}, // v67
+        {24, 67, 63322.32914586911}, // cr67
+        {25, 67, 63308.01860197367}, // mn67
+        {26, 67, 63295.8905487602}, // fe67
+        {27, 67, 63286.277180312965}, // co67
+        {28, 67, 63277.85627615037}, // ni67
+        {24, 68, 64257.402980121835}, // cr68
+        {25, 68, 64244.17296938521}, // mn68
+        {26, 68, 64229.19640720655}, // fe68
+        {27, 68, 64221.45047577999}, // co68
+        {28, 68, 64209.62924368293}, // ni68
+        {24, 69, 65194.957383169305}, // cr69
+        {25, 69, 65179.22724226179}, // mn69
+        {26, 69, 65165.38803438219}, // fe69
+        {27, 69, 65154.20172170625}, // co69
+        {28, 69, 65144.608512654384}, // ni69
+        {24, 70, 66130.4410748271}, // cr70
+        {25, 70, 66115.63125009279}, // mn70
+        {26, 70, 66099.19131067922}, // fe70
+        {27, 70, 66089.55630828146}, // co70
+        {28, 70, 66076.86740246891}, // ni70
+        {25, 71, 67050.95565625906}, // mn71
+        {26, 71, 67035.64561919174}, // fe71
+        {27, 71, 67023.2054437289}, // co71
+        {28, 71, 67012.16913793173}, // ni71
+        {25, 72, 67987.89993066946}, // mn72
+        {26, 72, 67969.81963014153}, // fe72
+        {27, 72, 67958.76931560456}, // co72
+        {28, 72, 67944.84340797988}, // ni72
+        {25, 73, 68923.86334178998}, // mn73
+        {26, 73, 68906.57387975501}, // fe73
+        {27, 73, 68892.59401626595}, // co73
+        {28, 73, 68880.45541947075}, // ni73
+        {26, 74, 69841.39807358832}, // fe74
+        {27, 74, 69828.51737314009}, // co74
+        {28, 74, 69813.35730662325}, // ni74
+        {26, 75, 70778.85187527271}, // fe75
+        {27, 75, 70762.99132519086}, // co75
+        {28, 75, 70749.31140280276}, // ni75
+        {26, 76, 71714.45572966973}, // fe76
+        {27, 76, 71699.38601808083}, // co76
+        {28, 76, 71682.85572373933}, // ni76
+        {27, 77, 72634.6303157543}, // co77
+        {28, 77, 72619.18986951263}, // ni77
+        {27, 78, 73572.71380745195}, // co78
+        {28, 78, 73553.15429428939}, // ni78
+        {28, 79, 74491.36819516137}, // ni79
+        {28, 80, 75427.78244942748}, // ni80
+        {28, 81, 76366.42670057478}, // ni81
+        {28, 82, 77303.29086649236}, // ni82
+    }};
+}
+
+#endif
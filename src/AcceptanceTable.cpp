@@ -0,0 +1,230 @@
+#include "AcceptanceTable.hh"
+
+#include <unistd.h>
+#include <sys/stat.h>
+
+AcceptanceTable::AcceptanceTable(const std::string &reaction, const std::vector<std::string> &detectors, const Axis &theta, const Axis &phi, const Axis &kinergy)
+{
+    if (reaction.size() >= sizeof(Header::reaction))
+    {
+        std::string msg = Form("reaction tag too long : %s", reaction.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    if (detectors.empty() || detectors.size() > MAX_DETECTORS)
+    {
+        std::string msg = Form("acceptance table needs 1 to %d detectors, got %zu", MAX_DETECTORS, detectors.size());
+        throw std::invalid_argument(msg.c_str());
+    }
+    for (const auto &name : detectors)
+    {
+        if (name.size() >= 16)
+        {
+            std::string msg = Form("detector name too long : %s", name.c_str());
+            throw std::invalid_argument(msg.c_str());
+        }
+    }
+    this->mReaction = reaction;
+    this->mDetectors = detectors;
+    this->mTheta = theta;
+    this->mPhi = phi;
+    this->mKinergy = kinergy;
+    this->mEfficiency.assign(static_cast<std::size_t>(detectors.size()) * Species::NumNuclei * theta.nbins * phi.nbins * kinergy.nbins, 0.);
+}
+
+AcceptanceTable::AcceptanceTable(const std::string &filename)
+{
+    std::FILE *in = std::fopen(filename.c_str(), "rb");
+    if (in == nullptr)
+    {
+        std::string msg = Form("cannot open file : %s", filename.c_str());
+        throw std::runtime_error(msg.c_str());
+    }
+
+    Header header;
+    bool valid = std::fread(&header, sizeof(header), 1, in) == 1 && std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == 2 && header.nspecies == Species::NumNuclei;
+    if (!valid)
+    {
+        std::fclose(in);
+        std::string msg = Form("%s is not an acceptance table of this version.", filename.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+
+    // the sizes are checked against the file before anything is allocated from them
+    auto sane = [](const Axis &axis)
+    { return axis.nbins > 0 && axis.nbins <= MAX_BINS && std::isfinite(axis.low) && std::isfinite(axis.high) && axis.low < axis.high; };
+    valid = header.ndetectors > 0 && header.ndetectors <= MAX_DETECTORS && header.ninputs <= MAX_INPUTS;
+    valid = valid && sane(header.theta) && sane(header.phi) && sane(header.kinergy);
+    std::size_t nefficiency = valid ? static_cast<std::size_t>(header.ndetectors) * Species::NumNuclei * header.theta.nbins * header.phi.nbins * header.kinergy.nbins : 0;
+    valid = valid && fs::file_size(filename) == sizeof(Header) + 16 * header.ndetectors + sizeof(Input) * header.ninputs + sizeof(float) * nefficiency;
+    if (!valid)
+    {
+        std::fclose(in);
+        std::string msg = Form("%s is truncated or corrupt.", filename.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    this->mReaction = std::string(header.reaction, strnlen(header.reaction, sizeof(header.reaction)));
+    this->mTheta = header.theta;
+    this->mPhi = header.phi;
+    this->mKinergy = header.kinergy;
+
+    for (unsigned int i = 0; i < header.ndetectors; i++)
+    {
+        char name[16];
+        valid &= std::fread(name, sizeof(name), 1, in) == 1;
+        this->mDetectors.push_back(std::string(name, strnlen(name, sizeof(name))));
+    }
+    this->mInputs.resize(header.ninputs);
+    valid &= std::fread(this->mInputs.data(), sizeof(Input), this->mInputs.size(), in) == this->mInputs.size();
+    for (auto &input : this->mInputs)
+    {
+        input.path[sizeof(input.path) - 1] = '\0';
+    }
+    this->mEfficiency.resize(nefficiency);
+    valid &= std::fread(this->mEfficiency.data(), sizeof(float), this->mEfficiency.size(), in) == this->mEfficiency.size();
+    std::fclose(in);
+    if (!valid)
+    {
+        std::string msg = Form("%s is truncated.", filename.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+}
+
+void AcceptanceTable::Write(const std::string &filename) const
+{
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = 2;
+    header.ndetectors = this->mDetectors.size();
+    header.nspecies = Species::NumNuclei;
+    header.ninputs = this->mInputs.size();
+    std::strcpy(header.reaction, this->mReaction.c_str());
+    header.theta = this->mTheta;
+    header.phi = this->mPhi;
+    header.kinergy = this->mKinergy;
+
+    // written to a unique file next to the target and renamed, so that a reader never sees a partial table
+    std::string tmp = filename + ".XXXXXX";
+    int descriptor = mkstemp(tmp.data());
+    if (descriptor < 0)
+    {
+        std::string msg = Form("cannot create a temporary file next to %s", filename.c_str());
+        throw std::runtime_error(msg.c_str());
+    }
+    fchmod(descriptor, 0644);
+    std::FILE *out = fdopen(descriptor, "wb");
+    if (out == nullptr)
+    {
+        close(descriptor);
+        std::remove(tmp.c_str());
+        std::string msg = Form("cannot open file : %s", tmp.c_str());
+        throw std::runtime_error(msg.c_str());
+    }
+    bool written = std::fwrite(&header, sizeof(header), 1, out) == 1;
+    for (const auto &detector : this->mDetectors)
+    {
+        char name[16] = {0};
+        std::strcpy(name, detector.c_str());
+        written &= std::fwrite(name, sizeof(name), 1, out) == 1;
+    }
+    written &= std::fwrite(this->mInputs.data(), sizeof(Input), this->mInputs.size(), out) == this->mInputs.size();
+    written &= std::fwrite(this->mEfficiency.data(), sizeof(float), this->mEfficiency.size(), out) == this->mEfficiency.size();
+    written &= std::fclose(out) == 0;
+    if (!written || std::rename(tmp.c_str(), filename.c_str()) != 0)
+    {
+        std::remove(tmp.c_str());
+        std::string msg = Form("cannot write acceptance table %s", filename.c_str());
+        throw std::runtime_error(msg.c_str());
+    }
+}
+
+void AcceptanceTable::SetInputs(const std::vector<std::string> &paths)
+{
+    if (paths.size() > MAX_INPUTS)
+    {
+        std::string msg = Form("too many inputs of an acceptance table : %zu", paths.size());
+        throw std::invalid_argument(msg.c_str());
+    }
+    this->mInputs.clear();
+    for (const auto &path : paths)
+    {
+        std::string absolute = fs::absolute(path).lexically_normal().string();
+        if (absolute.size() >= sizeof(Input::path))
+        {
+            std::string msg = Form("path too long : %s", absolute.c_str());
+            throw std::invalid_argument(msg.c_str());
+        }
+        Input input;
+        std::memset(&input, 0, sizeof(input));
+        std::strcpy(input.path, absolute.c_str());
+        input.size = fs::file_size(absolute);
+        input.mtime = fs::last_write_time(absolute).time_since_epoch().count();
+        this->mInputs.push_back(input);
+    }
+}
+
+std::vector<std::string> AcceptanceTable::GetInputs() const
+{
+    std::vector<std::string> paths;
+    for (const auto &input : this->mInputs)
+    {
+        paths.push_back(input.path);
+    }
+    return paths;
+}
+
+bool AcceptanceTable::HasInputs(const std::vector<std::string> &paths) const
+{
+    if (paths.size() != this->mInputs.size())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < paths.size(); i++)
+    {
+        if (fs::absolute(paths[i]).lexically_normal().string() != this->mInputs[i].path)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string AcceptanceTable::FindChangedInput() const
+{
+    for (const auto &input : this->mInputs)
+    {
+        std::error_code error;
+        uint64_t size = fs::file_size(input.path, error);
+        if (error)
+        {
+            return input.path;
+        }
+        auto mtime = fs::last_write_time(input.path, error);
+        if (error || size != input.size || mtime.time_since_epoch().count() != input.mtime)
+        {
+            return input.path;
+        }
+    }
+    return "";
+}
+
+int AcceptanceTable::GetDetectorID(const std::string &name) const
+{
+    for (unsigned int i = 0; i < this->mDetectors.size(); i++)
+    {
+        if (this->mDetectors[i] == name)
+        {
+            return i;
+        }
+    }
+    std::string msg = Form("acceptance table of %s has no detector %s", this->mReaction.c_str(), name.c_str());
+    throw std::invalid_argument(msg.c_str());
+}
+
+void AcceptanceTable::GetEfficiency(const std::size_t &n, const int &detector, const int *species, const double *theta_deg, const double *phi_deg, const double *kinergy_per_nucleon, double *efficiency) const
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        efficiency[i] = this->GetEfficiency(detector, species[i], theta_deg[i], phi_deg[i], kinergy_per_nucleon[i]);
+    }
+}
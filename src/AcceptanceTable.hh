@@ -0,0 +1,140 @@
+#ifndef AcceptanceTable_hh
+#define AcceptanceTable_hh
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+#include "TString.h"
+#include "Species.hh"
+
+/**
+ * @brief Binned single-particle efficiency of the detectors of one reaction over (species, theta_lab, phi, kinergy_lab per nucleon).
+ *
+ * Built once per reaction by filter_e15190 with the cuts of the filter and kept on disk (extension `.acc`), so that the
+ * analysis programs can weight unfiltered events instead of filtering them. Several particles in one event, e.g. two hits
+ * in one Microball CsI, are not modelled.
+ *
+ * Layout (native endianness):
+ *  - AcceptanceTable::Header
+ *  - char name[16] of each detector
+ *  - AcceptanceTable::Input of each file the table was built from
+ *  - float32 efficiency[ndetectors][Species::NumNuclei][theta][phi][kinergy]
+ *
+ * phi is the azimuth in degrees as returned by Physics::GetPhi, in [-180, 180], before any shift to the detector's range.
+ * The inputs record the size and modification time of the configuration files, so that a table older than them can be told apart.
+ */
+class AcceptanceTable
+{
+public:
+    struct Axis
+    {
+        int32_t nbins;
+        double low, high;
+
+        // bin of value in [low, high], the upper edge belongs to the last bin; -1 outside and for NaN
+        int Find(const double &value) const
+        {
+            double bin = std::floor((value - low) / (high - low) * nbins);
+            bool inside = (value >= low) & (value <= high);
+            return inside ? std::min(static_cast<int>(bin), nbins - 1) : -1;
+        }
+        double Low(const int &bin) const { return low + (high - low) * bin / nbins; }
+        double Width() const { return (high - low) / nbins; }
+    };
+
+    static constexpr char MAGIC[8] = {'A', 'C', 'C', 'T', 'A', 'B', '0', '2'};
+    // limits of a table read from a file
+    static constexpr int MAX_DETECTORS = 16;
+    static constexpr int MAX_INPUTS = 64;
+    static constexpr int MAX_BINS = 4096;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t ndetectors;
+        uint32_t nspecies;
+        uint32_t ninputs;
+        char reaction[36];
+        Axis theta, phi, kinergy;
+    };
+
+    // a file the table was built from, as it was at the time
+    struct Input
+    {
+        char path[256];
+        uint64_t size;
+        int64_t mtime;
+    };
+
+    // empty table, every efficiency 0
+    AcceptanceTable(const std::string &reaction, const std::vector<std::string> &detectors, const Axis &theta, const Axis &phi, const Axis &kinergy);
+    // table read from filename
+    AcceptanceTable(const std::string &filename);
+    ~AcceptanceTable() { ; }
+
+    // throws on failure, the file is then left as it was
+    void Write(const std::string &filename) const;
+
+    // record the current size and modification time of the files the table is built from
+    void SetInputs(const std::vector<std::string> &paths);
+    // absolute paths of the inputs
+    std::vector<std::string> GetInputs() const;
+    // whether the inputs are paths, in this order
+    bool HasInputs(const std::vector<std::string> &paths) const;
+    // first input that is missing or has changed since the table was built, empty if there is none
+    std::string FindChangedInput() const;
+
+    std::string GetReaction() const { return this->mReaction; }
+    const std::vector<std::string> &GetDetectors() const { return this->mDetectors; }
+    int GetDetectorID(const std::string &name) const;
+    const Axis &GetThetaAxis() const { return this->mTheta; }
+    const Axis &GetPhiAxis() const { return this->mPhi; }
+    const Axis &GetKinergyAxis() const { return this->mKinergy; }
+
+    // efficiency of one particle, 0 outside of the table and for species other than Species::Neutron ... Species::Helium4
+    double GetEfficiency(const int &detector, const int &species, const double &theta_deg, const double &phi_deg, const double &kinergy_per_nucleon) const
+    {
+        int index = this->Index(detector, species, theta_deg, phi_deg, kinergy_per_nucleon);
+        return index < 0 ? 0. : this->mEfficiency[index];
+    }
+
+    // efficiency of n particles at once
+    void GetEfficiency(const std::size_t &n, const int &detector, const int *species, const double *theta_deg, const double *phi_deg, const double *kinergy_per_nucleon, double *efficiency) const;
+
+    // kinergy bins of one (detector, species, theta, phi) cell, for filling the table
+    float *Row(const int &detector, const int &species, const int &itheta, const int &iphi)
+    {
+        return &this->mEfficiency[(((detector * Species::NumNuclei + species) * mTheta.nbins + itheta) * mPhi.nbins + iphi) * mKinergy.nbins];
+    }
+
+private:
+    int Index(const int &detector, const int &species, const double &theta_deg, const double &phi_deg, const double &kinergy_per_nucleon) const
+    {
+        int itheta = mTheta.Find(theta_deg);
+        int iphi = mPhi.Find(phi_deg);
+        int ikinergy = mKinergy.Find(kinergy_per_nucleon);
+        if (itheta < 0 || iphi < 0 || ikinergy < 0 || species < 0 || species >= Species::NumNuclei)
+        {
+            return -1;
+        }
+        return (((detector * Species::NumNuclei + species) * mTheta.nbins + itheta) * mPhi.nbins + iphi) * mKinergy.nbins + ikinergy;
+    }
+
+    std::string mReaction;
+    std::vector<std::string> mDetectors;
+    std::vector<Input> mInputs;
+    Axis mTheta, mPhi, mKinergy;
+    std::vector<float> mEfficiency;
+};
+
+#endif
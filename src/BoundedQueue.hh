@@ -0,0 +1,60 @@
+#ifndef BoundedQueue_hh
+#define BoundedQueue_hh
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * @brief Blocking first-in first-out queue of at most capacity items, between producer and consumer threads.
+ *
+ * Push() waits while the queue is full, Pop() waits while it is empty. After Close(), Pop() drains the remaining items and then returns false.
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+    BoundedQueue(const std::size_t &capacity) : mCapacity(capacity), mClosed(false) {}
+
+    void Push(T item)
+    {
+        std::unique_lock<std::mutex> lock(this->mMutex);
+        this->mNotFull.wait(lock, [this]()
+                            { return this->mItems.size() < this->mCapacity; });
+        this->mItems.push_back(std::move(item));
+        this->mNotEmpty.notify_one();
+    }
+
+    bool Pop(T &item)
+    {
+        std::unique_lock<std::mutex> lock(this->mMutex);
+        this->mNotEmpty.wait(lock, [this]()
+                             { return !this->mItems.empty() || this->mClosed; });
+        if (this->mItems.empty())
+        {
+            return false;
+        }
+        item = std::move(this->mItems.front());
+        this->mItems.pop_front();
+        this->mNotFull.notify_one();
+        return true;
+    }
+
+    // no more items will be pushed
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mClosed = true;
+        this->mNotEmpty.notify_all();
+    }
+
+private:
+    std::size_t mCapacity;
+    bool mClosed;
+    std::deque<T> mItems;
+    std::mutex mMutex;
+    std::condition_variable mNotFull;
+    std::condition_variable mNotEmpty;
+};
+
+#endif
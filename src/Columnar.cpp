@@ -0,0 +1,412 @@
+#include "Columnar.hh"
+
+ColumnarWriter::ColumnarWriter(const std::string &filename)
+{
+    this->mFilename = filename;
+    this->mMulti = nullptr;
+    this->mIndex = {0};
+    this->mClosed = false;
+}
+
+ColumnarWriter::~ColumnarWriter()
+{
+    if (!this->mClosed)
+    {
+        // a destructor must not throw; call Close() to get the error
+        try
+        {
+            this->Close();
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << error.what() << std::endl;
+        }
+    }
+}
+
+void ColumnarWriter::AddColumn(const std::string &name, const Columnar::Type &type, const bool &per_particle, const int *source_int, const double *source_double)
+{
+    if (name.size() >= sizeof(Columnar::ColumnEntry::name))
+    {
+        std::string msg = Form("column name too long : %s", name.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+
+    Column column;
+    column.name = name;
+    column.type = type;
+    column.per_particle = per_particle;
+    column.source_int = source_int;
+    column.source_double = source_double;
+    column.spill_path = this->mFilename + "." + name + ".tmp";
+    column.spill = std::fopen(column.spill_path.c_str(), "wb");
+    column.count = 0;
+    if (column.spill == nullptr)
+    {
+        std::string msg = Form("cannot open file : %s", column.spill_path.c_str());
+        throw std::runtime_error(msg.c_str());
+    }
+    this->mColumns.push_back(column);
+}
+
+void ColumnarWriter::Branch(const std::string &name, const int *source, const bool &per_particle)
+{
+    this->AddColumn(name, Columnar::kInt16, per_particle, source, nullptr);
+}
+
+void ColumnarWriter::Branch(const std::string &name, const double *source, const bool &per_particle)
+{
+    this->AddColumn(name, Columnar::kFloat32, per_particle, nullptr, source);
+}
+
+void ColumnarWriter::Fill()
+{
+    int multi = *this->mMulti;
+    try
+    {
+        for (auto &column : this->mColumns)
+        {
+            int n = column.per_particle ? multi : 1;
+            if (column.type == Columnar::kInt16)
+            {
+                this->mBufferInt.resize(n);
+                for (int i = 0; i < n; i++)
+                {
+                    this->mBufferInt[i] = column.source_int[i];
+                }
+                this->Write(this->mBufferInt.data(), sizeof(int16_t), n, column.spill, column.spill_path);
+            }
+            else
+            {
+                this->mBufferFloat.resize(n);
+                for (int i = 0; i < n; i++)
+                {
+                    this->mBufferFloat[i] = column.source_double[i];
+                }
+                this->Write(this->mBufferFloat.data(), sizeof(float), n, column.spill, column.spill_path);
+            }
+            column.count += n;
+        }
+    }
+    catch (...)
+    {
+        // the columns are out of step, nothing is left for Close() to assemble
+        this->RemoveSpills();
+        this->mClosed = true;
+        throw;
+    }
+    this->mIndex.push_back(this->mIndex.back() + multi);
+}
+
+void ColumnarWriter::Close()
+{
+    if (this->mClosed)
+    {
+        return;
+    }
+    this->mClosed = true;
+
+    auto align = [](const uint64_t &pos)
+    {
+        return (pos + Columnar::ALIGNMENT - 1) / Columnar::ALIGNMENT * Columnar::ALIGNMENT;
+    };
+    auto element_size = [](const Columnar::Type &type) -> uint64_t
+    {
+        return (type == Columnar::kInt16) ? sizeof(int16_t) : sizeof(float);
+    };
+
+    Columnar::Header header;
+    std::memcpy(header.magic, Columnar::MAGIC, sizeof(header.magic));
+    header.version = 1;
+    header.ncolumns = this->mColumns.size();
+    header.nevents = this->mIndex.size() - 1;
+    header.nparticles = this->mIndex.back();
+
+    std::vector<Columnar::ColumnEntry> entries(this->mColumns.size());
+    uint64_t pos = align(sizeof(header) + entries.size() * sizeof(Columnar::ColumnEntry));
+    for (unsigned int i = 0; i < this->mColumns.size(); i++)
+    {
+        std::memset(&entries[i], 0, sizeof(Columnar::ColumnEntry));
+        std::strcpy(entries[i].name, this->mColumns[i].name.c_str());
+        entries[i].type = this->mColumns[i].type;
+        entries[i].per_particle = this->mColumns[i].per_particle;
+        entries[i].offset = pos;
+        entries[i].count = this->mColumns[i].count;
+        pos = align(pos + entries[i].count * element_size(this->mColumns[i].type));
+    }
+    header.index_offset = pos;
+
+    std::FILE *out = std::fopen(this->mFilename.c_str(), "wb");
+    if (out == nullptr)
+    {
+        this->RemoveSpills();
+        std::string msg = Form("cannot open file : %s", this->mFilename.c_str());
+        throw std::runtime_error(msg.c_str());
+    }
+    try
+    {
+        this->Assemble(out, header, entries);
+    }
+    catch (...)
+    {
+        // no partial file whose header claims data that is not there
+        std::fclose(out);
+        std::remove(this->mFilename.c_str());
+        this->RemoveSpills();
+        throw;
+    }
+    if (std::fclose(out) != 0)
+    {
+        std::remove(this->mFilename.c_str());
+        std::string msg = Form("cannot write file : %s", this->mFilename.c_str());
+        throw std::runtime_error(msg.c_str());
+    }
+}
+
+void ColumnarWriter::Assemble(std::FILE *out, const Columnar::Header &header, const std::vector<Columnar::ColumnEntry> &entries)
+{
+    auto pad_to = [this, &out](const uint64_t &target)
+    {
+        static const char zeros[Columnar::ALIGNMENT] = {0};
+        long current = std::ftell(out);
+        this->Write(zeros, 1, target - current, out, this->mFilename);
+    };
+
+    this->Write(&header, sizeof(header), 1, out, this->mFilename);
+    this->Write(entries.data(), sizeof(Columnar::ColumnEntry), entries.size(), out, this->mFilename);
+
+    std::vector<char> buffer(1 << 20);
+    for (unsigned int i = 0; i < this->mColumns.size(); i++)
+    {
+        Column &column = this->mColumns[i];
+        pad_to(entries[i].offset);
+        bool closed = std::fclose(column.spill) == 0;
+        column.spill = nullptr;
+        std::FILE *spill = closed ? std::fopen(column.spill_path.c_str(), "rb") : nullptr;
+        if (spill == nullptr)
+        {
+            std::string msg = Form("cannot read back file : %s", column.spill_path.c_str());
+            throw std::runtime_error(msg.c_str());
+        }
+        std::size_t nbytes;
+        uint64_t total = 0;
+        while ((nbytes = std::fread(buffer.data(), 1, buffer.size(), spill)) > 0)
+        {
+            this->Write(buffer.data(), 1, nbytes, out, this->mFilename);
+            total += nbytes;
+        }
+        bool complete = !std::ferror(spill) && total == entries[i].count * ((column.type == Columnar::kInt16) ? sizeof(int16_t) : sizeof(float));
+        std::fclose(spill);
+        std::remove(column.spill_path.c_str());
+        if (!complete)
+        {
+            std::string msg = Form("cannot read back file : %s", column.spill_path.c_str());
+            throw std::runtime_error(msg.c_str());
+        }
+    }
+
+    pad_to(header.index_offset);
+    this->Write(this->mIndex.data(), sizeof(uint64_t), this->mIndex.size(), out, this->mFilename);
+}
+
+void ColumnarWriter::Write(const void *data, const std::size_t &size, const std::size_t &count, std::FILE *out, const std::string &path)
+{
+    if (std::fwrite(data, size, count, out) != count)
+    {
+        std::string msg = Form("cannot write file : %s", path.c_str());
+        throw std::runtime_error(msg.c_str());
+    }
+}
+
+void ColumnarWriter::RemoveSpills()
+{
+    for (auto &column : this->mColumns)
+    {
+        if (column.spill != nullptr)
+        {
+            std::fclose(column.spill);
+            column.spill = nullptr;
+        }
+        std::remove(column.spill_path.c_str());
+    }
+}
+
+void ColumnarChain::Add(const std::string &filename)
+{
+    auto file = std::make_unique<File>();
+    file->mapping = std::make_unique<MappedFile>(filename);
+
+    const char *data = file->mapping->Begin();
+    const uint64_t size = file->mapping->Size();
+    file->header = reinterpret_cast<const Columnar::Header *>(data);
+    if (size < sizeof(Columnar::Header) || std::memcmp(file->header->magic, Columnar::MAGIC, sizeof(Columnar::MAGIC)) != 0)
+    {
+        std::string msg = Form("%s is not a columnar AMD file.", filename.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+
+    // every section must lie within the mapping, e.g. not for a file cut short by a full disk
+    const Columnar::Header &header = *file->header;
+    auto corrupt = [&filename](const std::string &what)
+    {
+        std::string msg = Form("%s is corrupt : %s", filename.c_str(), what.c_str());
+        throw std::invalid_argument(msg.c_str());
+    };
+    auto fits = [&size](const uint64_t &offset, const uint64_t &count, const uint64_t &element)
+    {
+        return offset <= size && count <= (size - offset) / element;
+    };
+    if (!fits(sizeof(Columnar::Header), header.ncolumns, sizeof(Columnar::ColumnEntry)))
+    {
+        corrupt("column table beyond the end of the file");
+    }
+    const auto *entries = reinterpret_cast<const Columnar::ColumnEntry *>(data + sizeof(Columnar::Header));
+    for (unsigned int i = 0; i < header.ncolumns; i++)
+    {
+        const Columnar::ColumnEntry &entry = entries[i];
+        std::string name(entry.name, strnlen(entry.name, sizeof(entry.name)));
+        uint64_t element = (entry.type == Columnar::kInt16) ? sizeof(int16_t) : sizeof(float);
+        if (name.size() == sizeof(entry.name) || (entry.type != Columnar::kInt16 && entry.type != Columnar::kFloat32))
+        {
+            corrupt(Form("column %u", i));
+        }
+        if (entry.count != (entry.per_particle ? header.nparticles : header.nevents) || entry.offset % element != 0 || !fits(entry.offset, entry.count, element))
+        {
+            corrupt(Form("column %s beyond the end of the file", name.c_str()));
+        }
+        file->columns[name] = &entry;
+    }
+    if (header.nevents == std::numeric_limits<uint64_t>::max() || header.index_offset % sizeof(uint64_t) != 0 || !fits(header.index_offset, header.nevents + 1, sizeof(uint64_t)))
+    {
+        corrupt("event index beyond the end of the file");
+    }
+    file->index = reinterpret_cast<const uint64_t *>(data + header.index_offset);
+
+    // the index must describe nparticles in events of at most MAX_MULTI particles
+    if (file->index[0] != 0 || file->index[header.nevents] != header.nparticles)
+    {
+        corrupt("event index does not match the number of particles");
+    }
+    for (uint64_t i = 0; i < header.nevents; i++)
+    {
+        if (file->index[i + 1] < file->index[i] || file->index[i + 1] - file->index[i] > static_cast<uint64_t>(Columnar::MAX_MULTI))
+        {
+            corrupt(Form("event %lu has more than %d particles", static_cast<unsigned long>(i), Columnar::MAX_MULTI));
+        }
+    }
+    file->bindings = this->Bind(*file, this->mBranches);
+
+    this->mOffsets.push_back(this->mOffsets.back() + header.nevents);
+    this->mFiles.push_back(std::move(file));
+}
+
+void ColumnarChain::SetBranchAddress(const std::string &name, int *address)
+{
+    if (name == "multi")
+    {
+        this->mMulti = address;
+        return;
+    }
+    this->SetBranch({name, address, nullptr});
+}
+
+void ColumnarChain::SetBranchAddress(const std::string &name, double *address)
+{
+    this->SetBranch({name, nullptr, address});
+}
+
+void ColumnarChain::SetBranch(const Branch &branch)
+{
+    std::vector<Branch> branches = this->mBranches;
+    auto found = std::find_if(branches.begin(), branches.end(), [&branch](const Branch &other)
+                              { return other.name == branch.name; });
+    if (found != branches.end())
+    {
+        *found = branch;
+    }
+    else
+    {
+        branches.push_back(branch);
+    }
+
+    // resolved for every file first, so that a missing column leaves the chain as it was
+    std::vector<std::vector<Binding>> bindings;
+    for (const auto &file : this->mFiles)
+    {
+        bindings.push_back(this->Bind(*file, branches));
+    }
+    this->mBranches = branches;
+    for (unsigned int i = 0; i < this->mFiles.size(); i++)
+    {
+        this->mFiles[i]->bindings = bindings[i];
+    }
+}
+
+std::vector<ColumnarChain::Binding> ColumnarChain::Bind(const File &file, const std::vector<Branch> &branches) const
+{
+    std::vector<Binding> bindings;
+    for (const auto &branch : branches)
+    {
+        auto it = file.columns.find(branch.name);
+        if (it == file.columns.end())
+        {
+            std::string msg = Form("column %s does not exist.", branch.name.c_str());
+            throw std::invalid_argument(msg.c_str());
+        }
+        const Columnar::ColumnEntry *entry = it->second;
+        if (entry->type != ((branch.address_int != nullptr) ? Columnar::kInt16 : Columnar::kFloat32))
+        {
+            std::string msg = Form("column %s is requested with the wrong type.", branch.name.c_str());
+            throw std::invalid_argument(msg.c_str());
+        }
+        bindings.push_back({file.mapping->Begin() + entry->offset, entry->per_particle != 0, branch.address_int, branch.address_double});
+    }
+    return bindings;
+}
+
+int ColumnarChain::GetEntry(const long &ievt)
+{
+    if (ievt < 0 || ievt >= this->GetEntries())
+    {
+        return 0;
+    }
+    int ifile = std::upper_bound(this->mOffsets.begin(), this->mOffsets.end(), ievt) - this->mOffsets.begin() - 1;
+    const File &file = *this->mFiles[ifile];
+    long local = ievt - this->mOffsets[ifile];
+    uint64_t first = file.index[local];
+    int multi = file.index[local + 1] - first;
+
+    if (this->mMulti != nullptr)
+    {
+        *this->mMulti = multi;
+    }
+
+    for (const auto &binding : file.bindings)
+    {
+        if (binding.address_int != nullptr)
+        {
+            const auto *column = reinterpret_cast<const int16_t *>(binding.column);
+            if (binding.per_particle)
+            {
+                std::copy(column + first, column + first + multi, binding.address_int);
+            }
+            else
+            {
+                *binding.address_int = column[local];
+            }
+        }
+        else
+        {
+            const auto *column = reinterpret_cast<const float *>(binding.column);
+            if (binding.per_particle)
+            {
+                std::copy(column + first, column + first + multi, binding.address_double);
+            }
+            else
+            {
+                *binding.address_double = column[local];
+            }
+        }
+    }
+    return 1;
+}
@@ -0,0 +1,203 @@
+#ifndef Columnar_hh
+#define Columnar_hh
+
+#include <map>
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+#include "TString.h"
+#include "MappedFile.hh"
+
+/**
+ * @brief Columnar event file written by amd2root (extension `.amdc`), an alternative to the AMD TTree.
+ *
+ * Layout (native endianness, every section aligned to 64 bytes):
+ *  - Columnar::Header
+ *  - Columnar::ColumnEntry[ncolumns]
+ *  - one contiguous array per column; per-event columns hold nevents values, per-particle columns hold nparticles values
+ *  - event index : uint64[nevents + 1], particles of event i are [index[i], index[i + 1])
+ *
+ * Integer columns (N, Z, iFRG) are stored as int16, floating-point columns as float32. The float32 rounding is well below the
+ * precision of the AMD output, but the values are not bit-identical to the double branches of the TTree.
+ */
+namespace Columnar
+{
+    enum Type : uint32_t
+    {
+        kInt16 = 0,
+        kFloat32 = 1,
+    };
+
+    constexpr char MAGIC[8] = {'A', 'M', 'D', 'C', 'O', 'L', '0', '1'};
+    constexpr uint64_t ALIGNMENT = 64;
+    // particles per event, as AMD::MAX_MULTI
+    constexpr int MAX_MULTI = 128;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t ncolumns;
+        uint64_t nevents;
+        uint64_t nparticles;
+        uint64_t index_offset;
+    };
+
+    struct ColumnEntry
+    {
+        char name[16];
+        uint32_t type;
+        uint32_t per_particle;
+        uint64_t offset;
+        uint64_t count;
+    };
+
+    inline bool IsColumnarFile(const std::string &filename) { return fs::path(filename).extension() == ".amdc"; }
+};
+
+/**
+ * @brief Writes events to a columnar file, mirroring TTree::Branch / TTree::Fill.
+ *
+ * Each column is spilled to its own temporary file while filling, so memory use does not grow with the number of events;
+ * Close() assembles the final file.
+ * A failed write throws; a failure in Close() also removes the incomplete file.
+ */
+class ColumnarWriter
+{
+public:
+    ColumnarWriter(const std::string &filename);
+    ~ColumnarWriter();
+
+    // number of particles of the current event
+    void SetMulti(const int *multi) { this->mMulti = multi; }
+
+    // integer sources are stored as int16, floating-point sources as float32
+    void Branch(const std::string &name, const int *source, const bool &per_particle = true);
+    void Branch(const std::string &name, const double *source, const bool &per_particle = true);
+
+    void Fill();
+    void Close();
+    long GetEntries() const { return this->mIndex.size() - 1; }
+
+private:
+    struct Column
+    {
+        std::string name;
+        Columnar::Type type;
+        bool per_particle;
+        const int *source_int;
+        const double *source_double;
+        std::string spill_path;
+        std::FILE *spill;
+        uint64_t count;
+    };
+    void AddColumn(const std::string &name, const Columnar::Type &type, const bool &per_particle, const int *source_int, const double *source_double);
+    // the file from the spilled columns; every write is checked and throws on failure
+    void Assemble(std::FILE *out, const Columnar::Header &header, const std::vector<Columnar::ColumnEntry> &entries);
+    void Write(const void *data, const std::size_t &size, const std::size_t &count, std::FILE *out, const std::string &path);
+    void RemoveSpills();
+
+    std::string mFilename;
+    const int *mMulti;
+    std::vector<Column> mColumns;
+    std::vector<uint64_t> mIndex;
+    bool mClosed;
+
+    // conversion buffers of one event
+    std::vector<int16_t> mBufferInt;
+    std::vector<float> mBufferFloat;
+};
+
+/**
+ * @brief Reads one or more columnar files by mmap, mirroring TChain::Add / SetBranchAddress / GetEntry.
+ *
+ * The columns are used in place from the mapping; GetEntry() only widens the columns of one event into the addresses set
+ * by SetBranchAddress(). GetColumn() gives direct access to a mapped column.
+ * The columns of the addresses are looked up once per file, when the file or the address is added; a missing column throws there.
+ */
+class ColumnarChain
+{
+public:
+    ColumnarChain() { ; }
+    ~ColumnarChain() { ; }
+
+    void Add(const std::string &filename);
+    long GetEntries() const { return this->mOffsets.back(); }
+    int GetEntry(const long &ievt);
+
+    // "multi" receives the number of particles of the event
+    void SetBranchAddress(const std::string &name, int *address);
+    void SetBranchAddress(const std::string &name, double *address);
+
+    // direct access to the mapped data of file ifile
+    template <typename T>
+    const T *GetColumn(const int &ifile, const std::string &name) const;
+    const uint64_t *GetIndex(const int &ifile) const { return this->mFiles[ifile]->index; }
+    int GetNFiles() const { return this->mFiles.size(); }
+
+private:
+    // an address set by SetBranchAddress(), one of address_int and address_double
+    struct Branch
+    {
+        std::string name;
+        int *address_int;
+        double *address_double;
+    };
+    // a branch resolved to the mapped column of one file
+    struct Binding
+    {
+        const char *column;
+        bool per_particle;
+        int *address_int;
+        double *address_double;
+    };
+    struct File
+    {
+        std::unique_ptr<MappedFile> mapping;
+        const Columnar::Header *header;
+        const uint64_t *index;
+        std::map<std::string, const Columnar::ColumnEntry *> columns;
+        std::vector<Binding> bindings;
+    };
+    void SetBranch(const Branch &branch);
+    // the branches resolved to the columns of file; throws if a column is missing
+    std::vector<Binding> Bind(const File &file, const std::vector<Branch> &branches) const;
+
+    std::vector<std::unique_ptr<File>> mFiles;
+    std::vector<long> mOffsets = {0}; // first global entry of each file
+
+    int *mMulti = nullptr;
+    std::vector<Branch> mBranches;
+};
+
+template <typename T>
+const T *ColumnarChain::GetColumn(const int &ifile, const std::string &name) const
+{
+    const File &file = *this->mFiles[ifile];
+    if (file.columns.count(name) == 0)
+    {
+        std::string msg = Form("column %s does not exist.", name.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    const Columnar::ColumnEntry *entry = file.columns.at(name);
+    if ((std::is_same_v<T, int16_t> && entry->type != Columnar::kInt16) || (std::is_same_v<T, float> && entry->type != Columnar::kFloat32))
+    {
+        std::string msg = Form("column %s is requested with the wrong type.", name.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    return reinterpret_cast<const T *>(file.mapping->Begin() + entry->offset);
+}
+
+#endif
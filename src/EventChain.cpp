@@ -0,0 +1,114 @@
+#include "EventChain.hh"
+
+EventChain::EventChain(const std::string &tree_name)
+{
+    this->mTreeName = tree_name;
+    this->mChain = nullptr;
+    this->mColumnar = nullptr;
+}
+
+EventChain::~EventChain()
+{
+    delete this->mChain;
+    delete this->mColumnar;
+}
+
+void EventChain::Dispatch(const std::function<void()> &call)
+{
+    if (this->mChain == nullptr && this->mColumnar == nullptr)
+    {
+        this->mPending.push_back(call);
+        return;
+    }
+    call();
+}
+
+void EventChain::Add(const std::string &filename)
+{
+    bool columnar = Columnar::IsColumnarFile(filename);
+    if (this->mChain == nullptr && this->mColumnar == nullptr)
+    {
+        if (columnar)
+        {
+            this->mColumnar = new ColumnarChain();
+        }
+        else
+        {
+            this->mChain = new TChain(this->mTreeName.c_str());
+        }
+        for (auto &call : this->mPending)
+        {
+            call();
+        }
+        this->mPending.clear();
+    }
+
+    if (columnar != this->IsColumnar())
+    {
+        std::string msg = Form("cannot mix ROOT and columnar input : %s", filename.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+
+    if (this->IsColumnar())
+    {
+        this->mColumnar->Add(filename);
+    }
+    else
+    {
+        this->mChain->Add(filename.c_str());
+    }
+}
+
+long EventChain::GetEntries()
+{
+    if (this->IsColumnar())
+    {
+        return this->mColumnar->GetEntries();
+    }
+    return (this->mChain == nullptr) ? 0 : this->mChain->GetEntries();
+}
+
+int EventChain::GetEntry(const long &ievt)
+{
+    if (this->IsColumnar())
+    {
+        return this->mColumnar->GetEntry(ievt);
+    }
+    return this->mChain->GetEntry(ievt);
+}
+
+void EventChain::SetBranchAddress(const std::string &name, int *address)
+{
+    this->Dispatch([this, name, address]()
+                   {
+        if (this->IsColumnar())
+            this->mColumnar->SetBranchAddress(name, address);
+        else
+            this->mChain->SetBranchAddress(name.c_str(), address); });
+}
+
+void EventChain::SetBranchAddress(const std::string &name, double *address)
+{
+    this->Dispatch([this, name, address]()
+                   {
+        if (this->IsColumnar())
+            this->mColumnar->SetBranchAddress(name, address);
+        else
+            this->mChain->SetBranchAddress(name.c_str(), address); });
+}
+
+void EventChain::SetMakeClass(const int &flag)
+{
+    this->Dispatch([this, flag]()
+                   {
+        if (!this->IsColumnar())
+            this->mChain->SetMakeClass(flag); });
+}
+
+void EventChain::SetBranchStatus(const std::string &name, const bool &status)
+{
+    this->Dispatch([this, name, status]()
+                   {
+        if (!this->IsColumnar())
+            this->mChain->SetBranchStatus(name.c_str(), status); });
+}
@@ -0,0 +1,45 @@
+#ifndef EventChain_hh
+#define EventChain_hh
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "TChain.h"
+#include "Columnar.hh"
+
+/**
+ * @brief Input events from ROOT files through a TChain, or from columnar files written by amd2root (`.amdc`).
+ *
+ * The backend is chosen by the first file added. Calls made before that are replayed once it is known, so the branch
+ * addresses can be set before or after adding files, as with a TChain.
+ */
+class EventChain
+{
+public:
+    EventChain(const std::string &tree_name);
+    ~EventChain();
+
+    void Add(const std::string &filename);
+    long GetEntries();
+    int GetEntry(const long &ievt);
+
+    void SetBranchAddress(const std::string &name, int *address);
+    void SetBranchAddress(const std::string &name, double *address);
+
+    // only used by the TChain backend
+    void SetMakeClass(const int &flag);
+    void SetBranchStatus(const std::string &name, const bool &status);
+
+    bool IsColumnar() const { return this->mColumnar != nullptr; }
+
+private:
+    void Dispatch(const std::function<void()> &call);
+
+    std::string mTreeName;
+    TChain *mChain;
+    ColumnarChain *mColumnar;
+    std::vector<std::function<void()>> mPending;
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "EventKinematics.hh"
+
+template <typename P>
+EventKinematicsT<P>::EventKinematicsT(const Frame &frame, const unsigned int &columns, const double &betacms, const double &beam_rapidity)
+{
+    this->mFrame = frame;
+    this->mColumns = columns;
+    this->mBetacms = betacms;
+    this->mBeamRapidity = beam_rapidity;
+    this->mGamma = Physics::GetGamma<P>(this->mBetacms);
+
+    // the columns that are not requested are never written
+    const Real nan = std::numeric_limits<Real>::quiet_NaN();
+    for (auto column : {&phi, &pz_cms, &theta_cms, &kinergy_cms, &pmag_cms, &rapidity_cms, &pz_lab, &theta_lab, &kinergy_lab, &pmag_lab, &rapidity_lab, &rapidity_lab_normed})
+    {
+        column->fill(nan);
+    }
+    for (auto column : {&x, &y, &z_cms, &t_cms, &z_lab, &t_lab})
+    {
+        column->fill(std::numeric_limits<Real>::min());
+    }
+}
+
+template <typename P>
+void EventKinematicsT<P>::Fill(const std::size_t &n, const int *N, const int *Z, const double *px, const double *py, const double *pz, AME &ame, const bool &per_nucleon)
+{
+    if (n > MAX_MULTI)
+    {
+        std::string msg = Form("%zu particles in one event, at most %d.", n, MAX_MULTI);
+        throw std::invalid_argument(msg.c_str());
+    }
+    this->n = n;
+    bool cms = (this->mFrame == CMS);
+    std::array<Real, MAX_MULTI> &pz_input = cms ? this->pz_cms : this->pz_lab;
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        this->N[i] = N[i];
+        this->Z[i] = Z[i];
+        this->A[i] = N[i] + Z[i];
+        this->species[i] = Species::GetID(Z[i], this->A[i]);
+        double m = ame.GetMass(Z[i], this->A[i]);
+        this->mass[i] = (m == 0.) ? this->A[i] * 938.272 : m;
+    }
+
+    // the momentum columns, with the kernels of Physics::Batch
+    for (std::size_t i = 0; i < n; i++)
+    {
+        double scale = per_nucleon ? this->A[i] : 1.;
+        this->px[i] = px[i] * scale;
+        this->py[i] = py[i] * scale;
+        pz_input[i] = pz[i] * scale;
+    }
+    Physics::Batch::GetPt<P>(n, this->px.data(), this->py.data(), this->pmag_trans.data());
+    if (this->mColumns & Phi)
+    {
+        Physics::Batch::GetPhi<P>(n, this->px.data(), this->py.data(), this->phi.data());
+    }
+
+    if (cms)
+    {
+        this->FillFrame(true, this->pz_cms, this->pmag_cms, this->kinergy_cms, this->theta_cms, this->rapidity_cms);
+    }
+    else
+    {
+        this->FillFrame(true, this->pz_lab, this->pmag_lab, this->kinergy_lab, this->theta_lab, this->rapidity_lab);
+    }
+
+    if (this->mColumns & Boost)
+    {
+        // cms -> lab with -betacms, lab -> cms with betacms, the Lorentz factor is the same
+        const Real beta = cms ? -this->mBetacms : this->mBetacms;
+        const std::array<Real, MAX_MULTI> &kinergy = cms ? this->kinergy_cms : this->kinergy_lab;
+        std::array<Real, MAX_MULTI> &pz_boosted = cms ? this->pz_lab : this->pz_cms;
+        Physics::Batch::boostz<P>(n, this->mass.data(), pz_input.data(), kinergy.data(), beta, this->mGamma, pz_boosted.data());
+        if (cms)
+        {
+            this->FillFrame(false, this->pz_lab, this->pmag_lab, this->kinergy_lab, this->theta_lab, this->rapidity_lab);
+        }
+        else
+        {
+            this->FillFrame(false, this->pz_cms, this->pmag_cms, this->kinergy_cms, this->theta_cms, this->rapidity_cms);
+        }
+    }
+
+    if ((this->mColumns & Rapidity) && (!cms || (this->mColumns & Boost)))
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            this->rapidity_lab_normed[i] = this->rapidity_lab[i] / this->mBeamRapidity;
+        }
+    }
+}
+
+template <typename P>
+void EventKinematicsT<P>::FillFrame(const bool &input, const std::array<Real, MAX_MULTI> &pz, std::array<Real, MAX_MULTI> &pmag, std::array<Real, MAX_MULTI> &kinergy, std::array<Real, MAX_MULTI> &theta, std::array<Real, MAX_MULTI> &rapidity)
+{
+    // the kinergy of the input frame is also needed by the boost
+    if ((this->mColumns & (Kinergy | Rapidity)) || (input && (this->mColumns & Boost)))
+    {
+        Physics::Batch::GetP<P>(this->n, this->pmag_trans.data(), pz.data(), pmag.data());
+        Physics::Batch::GetEkin<P>(this->n, this->mass.data(), pmag.data(), kinergy.data());
+    }
+    if (this->mColumns & Theta)
+    {
+        Physics::Batch::GetTheta<P>(this->n, this->pmag_trans.data(), pz.data(), theta.data());
+    }
+    if (this->mColumns & Rapidity)
+    {
+        Physics::Batch::GetRapidity<P>(this->n, kinergy.data(), pz.data(), this->mass.data(), rapidity.data());
+    }
+}
+
+template <typename P>
+void EventKinematicsT<P>::SetSpaceTime(const double *x, const double *y, const double *z, const double *t)
+{
+    bool cms = (this->mFrame == CMS);
+    std::array<Real, MAX_MULTI> &z_input = cms ? this->z_cms : this->z_lab;
+    std::array<Real, MAX_MULTI> &t_input = cms ? this->t_cms : this->t_lab;
+    std::array<Real, MAX_MULTI> &z_boosted = cms ? this->z_lab : this->z_cms;
+    std::array<Real, MAX_MULTI> &t_boosted = cms ? this->t_lab : this->t_cms;
+    const Real beta = cms ? this->mBetacms : -this->mBetacms;
+
+    for (std::size_t i = 0; i < this->n; i++)
+    {
+        this->x[i] = x[i];
+        this->y[i] = y[i];
+        z_input[i] = z[i];
+        t_input[i] = t[i];
+        bool boost = (this->mColumns & Boost) && t_input[i] >= 0 && z_input[i] >= 0;
+        t_boosted[i] = boost ? this->mGamma * (t_input[i] + beta * z_input[i]) : std::numeric_limits<Real>::min();
+        z_boosted[i] = boost ? this->mGamma * (z_input[i] + beta * t_input[i]) : std::numeric_limits<Real>::min();
+    }
+}
+
+template class EventKinematicsT<Physics::Float>;
+template class EventKinematicsT<Physics::Double>;
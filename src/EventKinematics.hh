@@ -0,0 +1,92 @@
+#ifndef EventKinematics_hh
+#define EventKinematics_hh
+
+#include <array>
+#include <limits>
+#include <string>
+#include <stdexcept>
+
+#include "TMath.h"
+#include "AME.hh"
+#include "Physics.hh"
+#include "PhysicsBatch.hh"
+#include "Species.hh"
+
+/**
+ * @brief Kinematics of all particles of one event as columns, computed column by column instead of one Particle at a time.
+ *
+ * The columns are the members of Particle, computed by Physics::Batch in the precision policy P; EventKinematics has the
+ * policy of the build. At the Scalar level they equal Particle::Initialize(), at the vector levels they are within the
+ * bounds of PhysicsBatch.hh. Only the requested columns are computed, the others hold NaN.
+ */
+template <typename P>
+class EventKinematicsT
+{
+public:
+    typedef typename P::Real Real;
+    static const int MAX_MULTI = 128;
+
+    // frame of the momenta given to Fill()
+    enum Frame
+    {
+        CMS,
+        LAB,
+    };
+
+    // derived columns; N, Z, A, species, mass, px, py, pmag_trans and pz of the input frame are always filled
+    enum Column : unsigned int
+    {
+        Phi = 1 << 0,
+        Theta = 1 << 1,      // theta of every computed frame
+        Kinergy = 1 << 2,    // pmag and kinergy of every computed frame
+        Rapidity = 1 << 3,   // rapidity of every computed frame, and rapidity_lab_normed
+        Boost = 1 << 4,      // pz of the other frame, and the columns above in that frame
+        All = (1 << 5) - 1,
+    };
+
+    EventKinematicsT(const Frame &frame, const unsigned int &columns, const double &betacms, const double &beam_rapidity = 1.);
+    ~EventKinematicsT() { ; }
+
+    // kinematics of n particles, momenta per nucleon unless per_nucleon is false; masses missing from ame are A * 938.272
+    void Fill(const std::size_t &n, const int *N, const int *Z, const double *px, const double *py, const double *pz, AME &ame, const bool &per_nucleon = true);
+    // space-time in the input frame, after Fill(), boosted with Boost; otherwise x, y, z and t hold the smallest normal Real
+    void SetSpaceTime(const double *x, const double *y, const double *z, const double *t);
+
+    std::size_t Size() const { return this->n; }
+    Frame GetFrame() const { return this->mFrame; }
+    unsigned int GetColumns() const { return this->mColumns; }
+
+    std::size_t n = 0;
+    std::array<int, MAX_MULTI> N, Z, A, species;
+    std::array<Real, MAX_MULTI> mass;
+
+    // same in lab and cms
+    std::array<Real, MAX_MULTI> px, py, phi, pmag_trans;
+    std::array<Real, MAX_MULTI> x, y;
+
+    // cms quantities
+    std::array<Real, MAX_MULTI> pz_cms;
+    std::array<Real, MAX_MULTI> theta_cms, kinergy_cms, pmag_cms, rapidity_cms;
+    std::array<Real, MAX_MULTI> z_cms, t_cms;
+
+    // lab quantities
+    std::array<Real, MAX_MULTI> pz_lab;
+    std::array<Real, MAX_MULTI> theta_lab, kinergy_lab, pmag_lab, rapidity_lab;
+    std::array<Real, MAX_MULTI> z_lab, t_lab;
+
+    // rapidity lab / beam rapidity
+    std::array<Real, MAX_MULTI> rapidity_lab_normed;
+
+private:
+    // p, kinergy, theta and rapidity in one frame from pz of that frame, input for the frame of the momenta given to Fill()
+    void FillFrame(const bool &input, const std::array<Real, MAX_MULTI> &pz, std::array<Real, MAX_MULTI> &pmag, std::array<Real, MAX_MULTI> &kinergy, std::array<Real, MAX_MULTI> &theta, std::array<Real, MAX_MULTI> &rapidity);
+
+    Frame mFrame;
+    unsigned int mColumns;
+    // the Lorentz factor of the boost, Physics::GetGamma(betacms)
+    Real mBetacms, mBeamRapidity, mGamma;
+};
+
+typedef EventKinematicsT<Physics::Precision> EventKinematics;
+
+#endif
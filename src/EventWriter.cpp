@@ -0,0 +1,127 @@
+#include "EventWriter.hh"
+
+template <typename Mode>
+void Initialize_Tree(TTree *&tree, AMD &amd, const OutputProfile &profile)
+{
+    // Set base branches
+    tree->Branch("multi", &amd.multi, "multi/I");
+    tree->Branch("b", &amd.b, "b/D");
+    tree->Branch("N", &amd.N[0], "N[multi]/I");
+    tree->Branch("Z", &amd.Z[0], "Z[multi]/I");
+    tree->Branch("px", &amd.px[0], Form("px[multi]/%s", profile.MomentumLeaf()));
+    tree->Branch("py", &amd.py[0], Form("py[multi]/%s", profile.MomentumLeaf()));
+    tree->Branch("pz", &amd.pz[0], Form("pz[multi]/%s", profile.MomentumLeaf()));
+
+    if constexpr (Mode::has_table21)
+    {
+        tree->Branch("ENG", &amd.ENG[0], "ENG[multi]/D");
+        tree->Branch("LANG", &amd.LANG[0], "LANG[multi]/D");
+        tree->Branch("JX", &amd.JX[0], "JX[multi]/D");
+        tree->Branch("JY", &amd.JY[0], "JY[multi]/D");
+        tree->Branch("JZ", &amd.JZ[0], "JZ[multi]/D");
+    }
+
+    if constexpr (Mode::has_table3)
+    {
+        tree->Branch("J", &amd.J[0], "J[multi]/D");
+        tree->Branch("M", &amd.M[0], "M[multi]/D");
+        tree->Branch("WEIGHT", &amd.WEIGHT[0], "WEIGHT[multi]/D");
+        tree->Branch("iFRG", &amd.iFRG[0], "iFRG[multi]/I");
+    }
+
+    if constexpr (Mode::has_spacetime)
+    {
+        tree->Branch("t", &amd.t[0], "t[multi]/D");
+        tree->Branch("x", &amd.x[0], "x[multi]/D");
+        tree->Branch("y", &amd.y[0], "y[multi]/D");
+        tree->Branch("z", &amd.z[0], "z[multi]/D");
+    }
+    return;
+}
+
+template <typename Mode>
+void Attach_Tree(TTree *&tree, AMD &amd)
+{
+    // bind an existing tree written by Initialize_Tree, for appending
+    tree->SetBranchAddress("multi", &amd.multi);
+    tree->SetBranchAddress("b", &amd.b);
+    tree->SetBranchAddress("N", &amd.N[0]);
+    tree->SetBranchAddress("Z", &amd.Z[0]);
+    tree->SetBranchAddress("px", &amd.px[0]);
+    tree->SetBranchAddress("py", &amd.py[0]);
+    tree->SetBranchAddress("pz", &amd.pz[0]);
+
+    if constexpr (Mode::has_table21)
+    {
+        tree->SetBranchAddress("ENG", &amd.ENG[0]);
+        tree->SetBranchAddress("LANG", &amd.LANG[0]);
+        tree->SetBranchAddress("JX", &amd.JX[0]);
+        tree->SetBranchAddress("JY", &amd.JY[0]);
+        tree->SetBranchAddress("JZ", &amd.JZ[0]);
+    }
+
+    if constexpr (Mode::has_table3)
+    {
+        tree->SetBranchAddress("J", &amd.J[0]);
+        tree->SetBranchAddress("M", &amd.M[0]);
+        tree->SetBranchAddress("WEIGHT", &amd.WEIGHT[0]);
+        tree->SetBranchAddress("iFRG", &amd.iFRG[0]);
+    }
+
+    if constexpr (Mode::has_spacetime)
+    {
+        tree->SetBranchAddress("t", &amd.t[0]);
+        tree->SetBranchAddress("x", &amd.x[0]);
+        tree->SetBranchAddress("y", &amd.y[0]);
+        tree->SetBranchAddress("z", &amd.z[0]);
+    }
+    return;
+}
+
+template <typename Mode>
+void Initialize_Columnar(ColumnarWriter *&writer, AMD &amd)
+{
+    writer->SetMulti(&amd.multi);
+    writer->Branch("b", &amd.b, false);
+    writer->Branch("N", &amd.N[0]);
+    writer->Branch("Z", &amd.Z[0]);
+    writer->Branch("px", &amd.px[0]);
+    writer->Branch("py", &amd.py[0]);
+    writer->Branch("pz", &amd.pz[0]);
+
+    if constexpr (Mode::has_table21)
+    {
+        writer->Branch("ENG", &amd.ENG[0]);
+        writer->Branch("LANG", &amd.LANG[0]);
+        writer->Branch("JX", &amd.JX[0]);
+        writer->Branch("JY", &amd.JY[0]);
+        writer->Branch("JZ", &amd.JZ[0]);
+    }
+
+    if constexpr (Mode::has_table3)
+    {
+        writer->Branch("J", &amd.J[0]);
+        writer->Branch("M", &amd.M[0]);
+        writer->Branch("WEIGHT", &amd.WEIGHT[0]);
+        writer->Branch("iFRG", &amd.iFRG[0]);
+    }
+
+    if constexpr (Mode::has_spacetime)
+    {
+        writer->Branch("t", &amd.t[0]);
+        writer->Branch("x", &amd.x[0]);
+        writer->Branch("y", &amd.y[0]);
+        writer->Branch("z", &amd.z[0]);
+    }
+    return;
+}
+
+template void Initialize_Tree<TableMode::Table21>(TTree *&tree, AMD &amd, const OutputProfile &profile);
+template void Initialize_Tree<TableMode::Table3>(TTree *&tree, AMD &amd, const OutputProfile &profile);
+template void Initialize_Tree<TableMode::Table21t>(TTree *&tree, AMD &amd, const OutputProfile &profile);
+template void Attach_Tree<TableMode::Table21>(TTree *&tree, AMD &amd);
+template void Attach_Tree<TableMode::Table3>(TTree *&tree, AMD &amd);
+template void Attach_Tree<TableMode::Table21t>(TTree *&tree, AMD &amd);
+template void Initialize_Columnar<TableMode::Table21>(ColumnarWriter *&writer, AMD &amd);
+template void Initialize_Columnar<TableMode::Table3>(ColumnarWriter *&writer, AMD &amd);
+template void Initialize_Columnar<TableMode::Table21t>(ColumnarWriter *&writer, AMD &amd);
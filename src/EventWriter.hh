@@ -0,0 +1,133 @@
+#ifndef EventWriter_hh
+#define EventWriter_hh
+
+#include <string>
+#include <stdexcept>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TString.h"
+#include "TParameter.h"
+
+#include "AMDTable.hh"
+#include "Columnar.hh"
+#include "OutputProfile.hh"
+
+// branch setup per table mode, instantiated for TableMode::Table21, Table3 and Table21t in EventWriter.cpp
+template <typename Mode>
+void Initialize_Tree(TTree *&tree, AMD &amd, const OutputProfile &profile);
+template <typename Mode>
+void Attach_Tree(TTree *&tree, AMD &amd);
+template <typename Mode>
+void Initialize_Columnar(ColumnarWriter *&writer, AMD &amd);
+
+/**
+ * @brief Output of amd2root : the AMD TTree, or a columnar file (see Columnar.hh) if the output path ends with `.amdc`.
+ *
+ * The profile only applies to the TTree, a columnar file always stores float32.
+ *
+ * A ROOT output also stores a checkpoint: the byte offset into the input table after the last complete event (`checkpoint_offset`),
+ * the number of events (`checkpoint_events`) and a hash of the input before the offset (`checkpoint_hash`, see GetTableHash()).
+ * With append, an existing output is opened in UPDATE mode and the conversion continues from the checkpoint, if the input
+ * still has the same hash; the profile of the existing tree is kept.
+ */
+class EventWriter
+{
+public:
+    // record of the current event, bound to the output branches
+    AMD event;
+
+    // byte offset into the input table after the last complete event, set by the memory-mapped readers; -1 if unknown, then no checkpoint is written
+    long offset = 0;
+    // GetTableHash() of the input at offset
+    long hash = 0;
+
+    EventWriter(const std::string &path, const std::string &mode, const OutputProfile &profile = OutputProfile::Get("default"), const bool &append = false)
+    {
+        if (Columnar::IsColumnarFile(path))
+        {
+            if (append)
+            {
+                throw std::invalid_argument("append mode requires a ROOT output file");
+            }
+            columnar = new ColumnarWriter(path);
+            WithTableMode(mode, [this](auto table)
+                          { Initialize_Columnar<decltype(table)>(columnar, event); });
+            return;
+        }
+        if (append && fs::exists(path))
+        {
+            file = new TFile(path.c_str(), "UPDATE");
+            tree = file->Get<TTree>("AMD");
+            TParameter<Long64_t> *checkpoint_offset = file->Get<TParameter<Long64_t>>("checkpoint_offset");
+            TParameter<Long64_t> *checkpoint_events = file->Get<TParameter<Long64_t>>("checkpoint_events");
+            TParameter<Long64_t> *checkpoint_hash = file->Get<TParameter<Long64_t>>("checkpoint_hash");
+            if (tree == nullptr || checkpoint_offset == nullptr || checkpoint_events == nullptr || checkpoint_hash == nullptr)
+            {
+                std::string msg = Form("no checkpoint in %s, convert it again with -a and without -s", path.c_str());
+                delete file;
+                throw std::invalid_argument(msg.c_str());
+            }
+            if (checkpoint_events->GetVal() != tree->GetEntries())
+            {
+                std::string msg = Form("%s has %lld events but its checkpoint %lld", path.c_str(), (long long)tree->GetEntries(), (long long)checkpoint_events->GetVal());
+                delete file;
+                throw std::invalid_argument(msg.c_str());
+            }
+            offset = checkpoint_offset->GetVal();
+            hash = checkpoint_hash->GetVal();
+            WithTableMode(mode, [this](auto table)
+                          { Attach_Tree<decltype(table)>(tree, event); });
+            return;
+        }
+
+        // create the file first so that the baskets are flushed to disk while filling
+        file = new TFile(path.c_str(), "RECREATE");
+        profile.Apply(file);
+        file->cd();
+        tree = new TTree("AMD", "AMD");
+        WithTableMode(mode, [this, &profile](auto table)
+                      { Initialize_Tree<decltype(table)>(tree, event, profile); });
+        profile.Apply(tree);
+    }
+
+    void Fill()
+    {
+        if (columnar != nullptr)
+            columnar->Fill();
+        else
+            tree->Fill();
+    }
+
+    long GetEntries() const
+    {
+        return (columnar != nullptr) ? columnar->GetEntries() : tree->GetEntries();
+    }
+
+    void Close()
+    {
+        if (columnar != nullptr)
+        {
+            columnar->Close();
+            return;
+        }
+        file->cd();
+        tree->Write("", TObject::kOverwrite);
+        if (offset >= 0)
+        {
+            TParameter<Long64_t>("checkpoint_offset", offset).Write("", TObject::kOverwrite);
+            TParameter<Long64_t>("checkpoint_events", tree->GetEntries()).Write("", TObject::kOverwrite);
+            TParameter<Long64_t>("checkpoint_hash", hash).Write("", TObject::kOverwrite);
+        }
+        file->Close();
+    }
+
+private:
+    TFile *file = nullptr;
+    TTree *tree = nullptr;
+    ColumnarWriter *columnar = nullptr;
+};
+
+#endif
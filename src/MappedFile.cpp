@@ -0,0 +1,105 @@
+#include "MappedFile.hh"
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+MappedFile::MappedFile(const std::string &filename)
+{
+    this->mData = nullptr;
+    this->mSize = 0;
+    this->mDescriptor = -1;
+    this->mNextReadAhead = nullptr;
+    this->mReleased = nullptr;
+
+    if (!fs::exists(filename))
+    {
+        std::string msg = Form("file does not exist : %s", filename.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+
+    this->mDescriptor = open(filename.c_str(), O_RDONLY);
+    if (this->mDescriptor == -1)
+    {
+        std::string msg = Form("cannot open file : %s", filename.c_str());
+        throw std::runtime_error(msg.c_str());
+    }
+
+    struct stat info;
+    if (fstat(this->mDescriptor, &info) == -1)
+    {
+        close(this->mDescriptor);
+        std::string msg = Form("cannot stat file : %s", filename.c_str());
+        throw std::runtime_error(msg.c_str());
+    }
+
+    this->mSize = info.st_size;
+    if (this->mSize == 0)
+    {
+        return;
+    }
+
+    void *addr = mmap(nullptr, this->mSize, PROT_READ, MAP_PRIVATE, this->mDescriptor, 0);
+    if (addr == MAP_FAILED)
+    {
+        close(this->mDescriptor);
+        std::string msg = Form("cannot map file : %s", filename.c_str());
+        throw std::runtime_error(msg.c_str());
+    }
+    this->mData = static_cast<const char *>(addr);
+    this->mNextReadAhead = this->mData;
+    this->mReleased = this->mData;
+}
+
+MappedFile::~MappedFile()
+{
+    if (this->mData != nullptr)
+    {
+        munmap(const_cast<char *>(this->mData), this->mSize);
+    }
+    if (this->mDescriptor != -1)
+    {
+        close(this->mDescriptor);
+    }
+}
+
+void MappedFile::AdviseSequential()
+{
+    if (this->mData != nullptr)
+    {
+        madvise(const_cast<char *>(this->mData), this->mSize, MADV_SEQUENTIAL);
+    }
+}
+
+void MappedFile::ReadAhead(const char *pos, const std::size_t &window)
+{
+    // called once per record, only act when half of the window has been consumed
+    if (this->mData == nullptr || pos < this->mNextReadAhead)
+    {
+        return;
+    }
+    this->mNextReadAhead = pos + std::min(window / 2, (std::size_t)(this->End() - pos));
+
+    static const std::size_t page_size = sysconf(_SC_PAGESIZE);
+    auto page_floor = [this](const char *p)
+    {
+        return this->mData + ((p - this->mData) / page_size) * page_size;
+    };
+
+    const char *ahead_begin = page_floor(pos);
+    const char *ahead_end = pos + std::min(window, (std::size_t)(this->End() - pos));
+    madvise(const_cast<char *>(ahead_begin), ahead_end - ahead_begin, MADV_WILLNEED);
+
+    if ((std::size_t)(pos - this->mData) > window)
+    {
+        const char *release_end = page_floor(pos - window);
+        if (release_end > this->mReleased)
+        {
+            madvise(const_cast<char *>(this->mReleased), release_end - this->mReleased, MADV_DONTNEED);
+            this->mReleased = release_end;
+        }
+    }
+}
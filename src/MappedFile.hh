@@ -0,0 +1,45 @@
+#ifndef MappedFile_hh
+#define MappedFile_hh
+
+#include <string>
+#include <stdexcept>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+#include "TString.h"
+
+/**
+ * @brief Read-only memory map of a whole file, e.g. table21.dat / table3.dat.
+ *
+ * The mapping is released when the object goes out of scope. An empty file is represented by Begin() == End().
+ */
+class MappedFile
+{
+public:
+    MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *Begin() const { return this->mData; }
+    const char *End() const { return this->mData + this->mSize; }
+    std::size_t Size() const { return this->mSize; }
+
+    // hint the kernel that the mapping is read front to back
+    void AdviseSequential();
+
+    // prefetch [pos, pos + window) and release the pages before pos - window, so that a forward scan keeps a bounded resident set
+    void ReadAhead(const char *pos, const std::size_t &window = 32 << 20);
+
+private:
+    const char *mData;
+    std::size_t mSize;
+    int mDescriptor;
+
+    // read-ahead state
+    const char *mNextReadAhead;
+    const char *mReleased;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#include "OutputProfile.hh"
+
+OutputProfile OutputProfile::Get(const std::string &name, const bool &float_momenta)
+{
+    // ROOT::RCompressionSetting::EAlgorithm : kZLIB = 1, kLZMA = 2, kLZ4 = 4, kZSTD = 5
+    OutputProfile profile;
+    profile.name = name;
+    profile.float_momenta = float_momenta;
+    if (name == "default")
+    {
+        profile.compression = -1;
+        profile.basket_size = 0;
+        profile.auto_flush = 0;
+    }
+    else if (name == "fast-write")
+    {
+        profile.compression = 401;
+        profile.basket_size = 512 * 1024;
+        profile.auto_flush = -64 * 1024 * 1024;
+    }
+    else if (name == "fast-read")
+    {
+        profile.compression = 404;
+        profile.basket_size = 256 * 1024;
+        profile.auto_flush = -30 * 1024 * 1024;
+    }
+    else if (name == "smallest")
+    {
+        profile.compression = 208;
+        profile.basket_size = 1024 * 1024;
+        profile.auto_flush = -100 * 1024 * 1024;
+    }
+    else
+    {
+        std::string msg = Form("unknown output profile : %s, expect default, fast-write, fast-read or smallest", name.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    return profile;
+}
+
+void OutputProfile::Apply(TFile *file) const
+{
+    if (this->compression >= 0)
+    {
+        file->SetCompressionSettings(this->compression);
+    }
+}
+
+void OutputProfile::Apply(TTree *tree) const
+{
+    if (this->basket_size > 0)
+    {
+        tree->SetBasketSize("*", this->basket_size);
+    }
+    if (this->auto_flush != 0)
+    {
+        tree->SetAutoFlush(this->auto_flush);
+    }
+}
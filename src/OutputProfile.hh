@@ -0,0 +1,42 @@
+#ifndef OutputProfile_hh
+#define OutputProfile_hh
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TString.h"
+
+/**
+ * @brief Compression and basket settings of the output TTrees of amd2root and filter_e15190.
+ *
+ *  - "default"    : ROOT defaults, as before the profiles were introduced.
+ *  - "fast-write" : LZ4 at level 1 and large baskets, for conversions that are read only a few times.
+ *  - "fast-read"  : LZ4 at level 4, the cheapest decompression, with clusters sized for TTreeCache, for trees that are analyzed repeatedly.
+ *  - "smallest"   : LZMA at level 8 and large baskets, for archiving.
+ *
+ * With float_momenta, the momentum branches are Double32_t (leaf type `d`): float32 on disk, still read into double.
+ */
+struct OutputProfile
+{
+    std::string name;
+    int compression;  // ROOT compression settings, 100 * algorithm + level; -1 keeps the file default
+    int basket_size;  // bytes per basket of every branch; 0 keeps the Branch() default
+    long auto_flush;  // > 0 : entries per cluster, < 0 : compressed bytes per cluster, 0 keeps the ROOT default
+    bool float_momenta;
+
+    static OutputProfile Get(const std::string &name, const bool &float_momenta = false);
+    static std::vector<std::string> GetNames() { return {"default", "fast-write", "fast-read", "smallest"}; }
+
+    // call before the tree is created, branches take their compression from the file
+    void Apply(TFile *file) const;
+    // call after the branches are created
+    void Apply(TTree *tree) const;
+
+    // leaf type of floating-point momentum branches, e.g. Form("px[multi]/%s", profile.MomentumLeaf())
+    const char *MomentumLeaf() const { return this->float_momenta ? "d" : "D"; }
+};
+
+#endif
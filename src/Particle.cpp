@@ -1,10 +1,12 @@
 #include "Particle.hh"
 
-Particle::Particle(const int &N, const int &Z, const double &px_per_nucleon, const double &py_per_nucleon, const double &pz_per_nucleon, const double &m, const std::string &frame)
+template <typename P>
+ParticleT<P>::ParticleT(const int &N, const int &Z, const double &px_per_nucleon, const double &py_per_nucleon, const double &pz_per_nucleon, const double &m, const std::string &frame)
 {
     this->N = N;
     this->Z = Z;
     this->A = N + Z;
+    this->species = Species::GetID(Z, this->A);
 
     this->px = px_per_nucleon * A;
     this->py = py_per_nucleon * A;
@@ -18,79 +20,118 @@ Particle::Particle(const int &N, const int &Z, const double &px_per_nucleon, con
     this->_frame_at_construct = frame;
 
     // initialize frame-independent quantities
-    this->phi = Physics::GetPhi(this->px, this->py);
-    this->pmag_trans = Physics::GetPt(this->px, this->py);
+    this->phi = Physics::GetPhi<P>(this->px, this->py);
+    this->pmag_trans = Physics::GetPt<P>(this->px, this->py);
 
     if (frame == "cms")
     {
         // initialize cms quantities
         this->pz_cms = pz_per_nucleon * A;
-        this->pmag_cms = Physics::GetP(this->pmag_trans, this->pz_cms);
-        this->kinergy_cms = Physics::GetEkin(this->mass, this->pmag_cms);
-        this->theta_cms = Physics::GetTheta(this->pmag_trans, this->pz_cms);
-        this->rapidity_cms = Physics::GetRapidity(this->kinergy_cms, this->pz_cms, this->mass);
+        this->pmag_cms = Physics::GetP<P>(this->pmag_trans, this->pz_cms);
+        this->kinergy_cms = Physics::GetEkin<P>(this->mass, this->pmag_cms);
+        this->theta_cms = Physics::GetTheta<P>(this->pmag_trans, this->pz_cms);
+        this->rapidity_cms = Physics::GetRapidity<P>(this->kinergy_cms, this->pz_cms, this->mass);
     }
 
     else if (frame == "lab")
     {
         // initialize lab quantities
         this->pz_lab = pz_per_nucleon * A;
-        this->pmag_lab = Physics::GetP(this->pmag_trans, this->pz_lab);
-        this->kinergy_lab = Physics::GetEkin(this->mass, this->pmag_lab);
-        this->theta_lab = Physics::GetTheta(this->pmag_trans, this->pz_lab);
-        this->rapidity_lab = Physics::GetRapidity(this->kinergy_lab, this->pz_lab, this->mass);
+        this->pmag_lab = Physics::GetP<P>(this->pmag_trans, this->pz_lab);
+        this->kinergy_lab = Physics::GetEkin<P>(this->mass, this->pmag_lab);
+        this->theta_lab = Physics::GetTheta<P>(this->pmag_trans, this->pz_lab);
+        this->rapidity_lab = Physics::GetRapidity<P>(this->kinergy_lab, this->pz_lab, this->mass);
     }
 
-    // by default, x, y, z, t are set to DBL_MIN
-    this->x = DBL_MIN;
-    this->y = DBL_MIN;
-    this->z_cms = DBL_MIN;
-    this->t_cms = DBL_MIN;
-    this->z_lab = DBL_MIN;
-    this->t_lab = DBL_MIN;
+    // by default, x, y, z, t are set to the smallest normal Real (DBL_MIN for double)
+    this->x = std::numeric_limits<Real>::min();
+    this->y = std::numeric_limits<Real>::min();
+    this->z_cms = std::numeric_limits<Real>::min();
+    this->t_cms = std::numeric_limits<Real>::min();
+    this->z_lab = std::numeric_limits<Real>::min();
+    this->t_lab = std::numeric_limits<Real>::min();
 }
 
-void Particle::Initialize(const double &betacms, const double &beam_rapidity)
+template <typename P>
+ParticleT<P>::ParticleT(const EventKinematicsT<P> &event, const std::size_t &i)
 {
-    double gamma = 1. / TMath::Sqrt(1 - pow(betacms, 2.));
+    this->N = event.N[i];
+    this->Z = event.Z[i];
+    this->A = event.A[i];
+    this->species = event.species[i];
+    this->mass = event.mass[i];
+    this->_frame_at_construct = (event.GetFrame() == EventKinematicsT<P>::CMS) ? "cms" : "lab";
+
+    this->px = event.px[i];
+    this->py = event.py[i];
+    this->phi = event.phi[i];
+    this->pmag_trans = event.pmag_trans[i];
+    this->x = event.x[i];
+    this->y = event.y[i];
+
+    this->pz_cms = event.pz_cms[i];
+    this->theta_cms = event.theta_cms[i];
+    this->kinergy_cms = event.kinergy_cms[i];
+    this->pmag_cms = event.pmag_cms[i];
+    this->rapidity_cms = event.rapidity_cms[i];
+    this->z_cms = event.z_cms[i];
+    this->t_cms = event.t_cms[i];
+
+    this->pz_lab = event.pz_lab[i];
+    this->theta_lab = event.theta_lab[i];
+    this->kinergy_lab = event.kinergy_lab[i];
+    this->pmag_lab = event.pmag_lab[i];
+    this->rapidity_lab = event.rapidity_lab[i];
+    this->z_lab = event.z_lab[i];
+    this->t_lab = event.t_lab[i];
+
+    this->rapidity_lab_normed = event.rapidity_lab_normed[i];
+}
+
+template <typename P>
+void ParticleT<P>::Initialize(const double &betacms, const double &beam_rapidity)
+{
+    const Real beta = betacms;
+    const Real gamma = Physics::GetGamma<P>(beta);
 
     if (this->_frame_at_construct == "cms")
     {
         // construct lab quantities
-        this->pz_lab = Physics::boostz(this->mass, this->pz_cms, this->kinergy_cms, -betacms);
-        this->pmag_lab = Physics::GetP(this->pmag_trans, this->pz_lab);
-        this->kinergy_lab = Physics::GetEkin(this->mass, this->pmag_lab);
-        this->theta_lab = Physics::GetTheta(this->pmag_trans, this->pz_lab);
-        this->rapidity_lab = Physics::GetRapidity(this->kinergy_lab, this->pz_lab, this->mass);
+        this->pz_lab = Physics::boostz<P>(this->mass, this->pz_cms, this->kinergy_cms, -beta, gamma);
+        this->pmag_lab = Physics::GetP<P>(this->pmag_trans, this->pz_lab);
+        this->kinergy_lab = Physics::GetEkin<P>(this->mass, this->pmag_lab);
+        this->theta_lab = Physics::GetTheta<P>(this->pmag_trans, this->pz_lab);
+        this->rapidity_lab = Physics::GetRapidity<P>(this->kinergy_lab, this->pz_lab, this->mass);
 
         //
         if (this->t_cms >= 0. && this->z_cms >= 0.)
         {
-            this->t_lab = gamma * (this->t_cms + betacms * this->z_cms);
-            this->z_lab = gamma * (this->z_cms + betacms * this->t_cms);
+            this->t_lab = gamma * (this->t_cms + beta * this->z_cms);
+            this->z_lab = gamma * (this->z_cms + beta * this->t_cms);
         }
     }
     else if (this->_frame_at_construct == "lab")
     {
         // construct cms quantities
-        this->pz_cms = Physics::boostz(this->mass, this->pz_lab, this->kinergy_lab, betacms);
-        this->pmag_cms = Physics::GetP(this->pmag_trans, this->pz_cms);
-        this->kinergy_cms = Physics::GetEkin(this->mass, this->pmag_cms);
-        this->theta_cms = Physics::GetTheta(this->pmag_trans, this->pz_cms);
-        this->rapidity_cms = Physics::GetRapidity(this->kinergy_cms, this->pz_cms, this->mass);
+        this->pz_cms = Physics::boostz<P>(this->mass, this->pz_lab, this->kinergy_lab, beta, gamma);
+        this->pmag_cms = Physics::GetP<P>(this->pmag_trans, this->pz_cms);
+        this->kinergy_cms = Physics::GetEkin<P>(this->mass, this->pmag_cms);
+        this->theta_cms = Physics::GetTheta<P>(this->pmag_trans, this->pz_cms);
+        this->rapidity_cms = Physics::GetRapidity<P>(this->kinergy_cms, this->pz_cms, this->mass);
 
         if (this->t_lab >= 0. && z_lab >= 0.)
         {
-            this->t_cms = gamma * (this->t_lab - betacms * this->z_lab);
-            this->z_cms = gamma * (this->z_lab - betacms * this->t_lab);
+            this->t_cms = gamma * (this->t_lab - beta * this->z_lab);
+            this->z_cms = gamma * (this->z_lab - beta * this->t_lab);
         }
     }
 
     // normalize rapidity to beam rapidity
-    this->rapidity_lab_normed = this->rapidity_lab / beam_rapidity;
+    this->rapidity_lab_normed = this->rapidity_lab / static_cast<Real>(beam_rapidity);
 }
 
-void Particle::SetXYZT(const double &x, const double &y, const double &z, const double &t, const std::string &frame)
+template <typename P>
+void ParticleT<P>::SetXYZT(const double &x, const double &y, const double &z, const double &t, const std::string &frame)
 {
     this->x = x;
     this->y = y;
@@ -105,4 +146,7 @@ void Particle::SetXYZT(const double &x, const double &y, const double &z, const
         this->z_lab = z;
         this->t_lab = t;
     }
-}
\ No newline at end of file
+}
+
+template class ParticleT<Physics::Float>;
+template class ParticleT<Physics::Double>;
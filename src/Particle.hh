@@ -3,36 +3,47 @@
 
 #include "TMath.h"
 #include "Physics.hh"
-
-class Particle
+#include "Species.hh"
+#include "EventKinematics.hh"
+
+/**
+ * @brief Kinematics of one particle in the precision policy P of Physics; Particle has the policy of the build.
+ */
+template <typename P>
+class ParticleT
 {
 public:
-    Particle(const int &N, const int &Z, const double &px_per_nucleon, const double &py_per_nucleon, const double &pz_per_nucleon, const double &m = 0., const std::string &frame = "cms");
-    ~Particle() { ; }
+    typedef typename P::Real Real;
+
+    ParticleT(const int &N, const int &Z, const double &px_per_nucleon, const double &py_per_nucleon, const double &pz_per_nucleon, const double &m = 0., const std::string &frame = "cms");
+    // view of particle i of an event, with the columns computed by the EventKinematicsT; Initialize() is not needed
+    ParticleT(const EventKinematicsT<P> &event, const std::size_t &i);
+    ~ParticleT() { ; }
 
     void Initialize(const double &betacms, const double &beam_rapidity = 1.);
 
     void SetXYZT(const double &x, const double &y, const double &z, const double &t, const std::string &frame = "cms");
 
     int N, Z, A;
-    double mass;
+    int species; // Species::ID, Species::Unknown outside of the registry
+    Real mass;
 
     // same in lab and cms
-    double px, py, phi, pmag_trans;
-    double x, y;
+    Real px, py, phi, pmag_trans;
+    Real x, y;
 
     // cms quantities
-    double pz_cms;
-    double theta_cms, kinergy_cms, pmag_cms, rapidity_cms;
-    double z_cms, t_cms;
+    Real pz_cms;
+    Real theta_cms, kinergy_cms, pmag_cms, rapidity_cms;
+    Real z_cms, t_cms;
 
     // lab quantities
-    double pz_lab;
-    double theta_lab, kinergy_lab, pmag_lab, rapidity_lab;
-    double z_lab, t_lab;
+    Real pz_lab;
+    Real theta_lab, kinergy_lab, pmag_lab, rapidity_lab;
+    Real z_lab, t_lab;
 
     // rapidity lab / beam rapidity
-    double rapidity_lab_normed;
+    Real rapidity_lab_normed;
 
 private:
     std::string _frame_at_construct;
@@ -40,4 +51,7 @@ private:
 protected:
     double NucleonMass = 938.272; // MeV/c^2
 };
+
+typedef ParticleT<Physics::Precision> Particle;
+
 #endif
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <fstream>
 #include <map>
 #include <regex>
+#include <cmath>
 
 #include "TMath.h"
 #include "TString.h"
@@ -17,16 +18,108 @@ namespace Physics
     double GetReactionBeta(const double &mass1, const double &mass2, const double &beam_energy_per_nucleon, const int &beam_nucleon);
     double GetBeamRapidity(const double &mass1, const double &mass2, const double &beam_energy_per_nucleon, const int &beam_nucleon);
 
-    // general physics
-    float GetPt(const float &px, const float &py);
-    float GetP(const float &pt, const float &pz);
-    float GetP(const float &px, const float &py, const float &pz);
-    float GetEkin(const float &mass, const float &px, const float &py, const float &pz);
-    float GetEkin(const float &mass, const float &p);
-    float GetPhi(const float &px, const float &py);
-    float GetTheta(const float &pt, const float &pz);
-    float boostz(const float &mass, const float &pz, const float &ekin, const float &betacms);
-    float GetRapidity(const float &ekin, const float &pz, const float &mass);
+    // precision policies of the kinematics : Float is the fast path for the histograms, Double the reference
+    struct Float
+    {
+        typedef float Real;
+        static std::string GetName() { return "float"; }
+    };
+
+    struct Double
+    {
+        typedef double Real;
+        static std::string GetName() { return "double"; }
+    };
+
+    // precision of the build, double with -DPHYSICS_DOUBLE (make PRECISION=double)
+#ifdef PHYSICS_DOUBLE
+    typedef Double Precision;
+#else
+    typedef Float Precision;
+#endif
+    typedef Precision::Real Real;
+
+    // general physics, evaluated entirely in P::Real; inline so that the column loops of EventKinematics can be optimized across the calls
+    template <typename P = Precision>
+    inline typename P::Real GetPt(const typename P::Real &px, const typename P::Real &py)
+    {
+        return std::sqrt(px * px + py * py);
+    }
+
+    template <typename P = Precision>
+    inline typename P::Real GetP(const typename P::Real &pt, const typename P::Real &pz)
+    {
+        return std::sqrt(pt * pt + pz * pz);
+    }
+
+    template <typename P = Precision>
+    inline typename P::Real GetP(const typename P::Real &px, const typename P::Real &py, const typename P::Real &pz)
+    {
+        return Physics::GetP<P>(Physics::GetPt<P>(px, py), pz);
+    }
+
+    // sqrt(p^2 + m^2) - m, written without the cancellation for p << m
+    template <typename P = Precision>
+    inline typename P::Real GetEkin(const typename P::Real &mass, const typename P::Real &p)
+    {
+        typename P::Real energy = std::sqrt(p * p + mass * mass) + mass;
+        return (energy > 0) ? p * p / energy : 0;
+    }
+
+    template <typename P = Precision>
+    inline typename P::Real GetEkin(const typename P::Real &mass, const typename P::Real &px, const typename P::Real &py, const typename P::Real &pz)
+    {
+        return Physics::GetEkin<P>(mass, Physics::GetP<P>(px, py, pz));
+    }
+
+    // 0 at px = py = 0 as TMath::ATan2
+    template <typename P = Precision>
+    inline typename P::Real GetPhi(const typename P::Real &px, const typename P::Real &py)
+    {
+        return (px == 0 && py == 0) ? 0 : std::atan2(py, px);
+    }
+
+    template <typename P = Precision>
+    inline typename P::Real GetTheta(const typename P::Real &pt, const typename P::Real &pz)
+    {
+        return (pz == 0 && pt == 0) ? 0 : std::atan2(pt, pz);
+    }
+
+    // Lorentz factor of boostz()
+    template <typename P = Precision>
+    inline typename P::Real GetGamma(const typename P::Real &betacms)
+    {
+        return 1 / std::sqrt(1 - betacms * betacms);
+    }
+
+    // boostz() with the Lorentz factor of betacms computed once by GetGamma()
+    template <typename P = Precision>
+    inline typename P::Real boostz(const typename P::Real &mass, const typename P::Real &pz, const typename P::Real &ekin, const typename P::Real &betacms, const typename P::Real &gamma)
+    {
+        return gamma * (pz - betacms * (ekin + mass));
+    }
+
+    /**
+     * @brief Boost from lab frame to cms frame if betacms is positive
+     *
+     * @param mass
+     * @param pz
+     * @param ekin
+     * @param betacms
+     * @return P::Real
+     */
+    template <typename P = Precision>
+    inline typename P::Real boostz(const typename P::Real &mass, const typename P::Real &pz, const typename P::Real &ekin, const typename P::Real &betacms)
+    {
+        return Physics::boostz<P>(mass, pz, ekin, betacms, Physics::GetGamma<P>(betacms));
+    }
+
+    // 0.5 ln((E + pz) / (E - pz)) as 0.5 ln(1 + 2 pz / (E - pz)), accurate at small rapidity as well
+    template <typename P = Precision>
+    inline typename P::Real GetRapidity(const typename P::Real &ekin, const typename P::Real &pz, const typename P::Real &mass)
+    {
+        return std::log1p(2 * pz / (ekin - pz + mass)) / 2;
+    }
 
 };
 
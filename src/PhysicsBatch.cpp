@@ -0,0 +1,283 @@
+#include "PhysicsBatch.hh"
+
+#include <array>
+#include <algorithm>
+
+// the vector levels use the x86-64 targets and vector extensions of GCC; elsewhere, e.g. on aarch64 or with clang, only the scalar level exists
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define PHYSICS_BATCH_VECTOR
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // one entry per kernel of Physics::Batch
+    template <typename Real>
+    struct Kernels
+    {
+        void (*GetPt)(const std::size_t &, const Real *, const Real *, Real *);
+        void (*GetP)(const std::size_t &, const Real *, const Real *, Real *);
+        void (*GetEkin)(const std::size_t &, const Real *, const Real *, Real *);
+        void (*GetPhi)(const std::size_t &, const Real *, const Real *, Real *);
+        void (*GetTheta)(const std::size_t &, const Real *, const Real *, Real *);
+        void (*boostz)(const std::size_t &, const Real *, const Real *, const Real *, const Real &, const Real &, Real *);
+        void (*GetRapidity)(const std::size_t &, const Real *, const Real *, const Real *, Real *);
+    };
+
+    namespace scalar
+    {
+        template <typename P>
+        void GetPt(const std::size_t &n, const typename P::Real *px, const typename P::Real *py, typename P::Real *pt)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                pt[i] = Physics::GetPt<P>(px[i], py[i]);
+            }
+        }
+
+        template <typename P>
+        void GetP(const std::size_t &n, const typename P::Real *pt, const typename P::Real *pz, typename P::Real *p)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                p[i] = Physics::GetP<P>(pt[i], pz[i]);
+            }
+        }
+
+        template <typename P>
+        void GetEkin(const std::size_t &n, const typename P::Real *mass, const typename P::Real *p, typename P::Real *ekin)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                ekin[i] = Physics::GetEkin<P>(mass[i], p[i]);
+            }
+        }
+
+        template <typename P>
+        void GetPhi(const std::size_t &n, const typename P::Real *px, const typename P::Real *py, typename P::Real *phi)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                phi[i] = Physics::GetPhi<P>(px[i], py[i]);
+            }
+        }
+
+        template <typename P>
+        void GetTheta(const std::size_t &n, const typename P::Real *pt, const typename P::Real *pz, typename P::Real *theta)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                theta[i] = Physics::GetTheta<P>(pt[i], pz[i]);
+            }
+        }
+
+        template <typename P>
+        void boostz(const std::size_t &n, const typename P::Real *mass, const typename P::Real *pz, const typename P::Real *ekin, const typename P::Real &betacms, const typename P::Real &gamma, typename P::Real *pz_boosted)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                pz_boosted[i] = Physics::boostz<P>(mass[i], pz[i], ekin[i], betacms, gamma);
+            }
+        }
+
+        template <typename P>
+        void GetRapidity(const std::size_t &n, const typename P::Real *ekin, const typename P::Real *pz, const typename P::Real *mass, typename P::Real *rapidity)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                rapidity[i] = Physics::GetRapidity<P>(ekin[i], pz[i], mass[i]);
+            }
+        }
+
+        template <typename P>
+        const Kernels<typename P::Real> KERNELS = {GetPt<P>, GetP<P>, GetEkin<P>, GetPhi<P>, GetTheta<P>, boostz<P>, GetRapidity<P>};
+    };
+
+#ifdef PHYSICS_BATCH_VECTOR
+// the vector levels are compiled for their instruction set whatever the flags of the build, and only called if the CPU has it;
+// no contraction into FMA, so that both levels give the same results
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#pragma GCC optimize("fp-contract=off")
+    namespace avx2
+    {
+        typedef float F __attribute__((vector_size(32)));
+        typedef int I __attribute__((vector_size(32)));
+
+        inline F Load(const float *x)
+        {
+            return (F)_mm256_loadu_ps(x);
+        }
+
+        inline void Store(float *out, const F &x)
+        {
+            _mm256_storeu_ps(out, (__m256)x);
+        }
+
+        inline F Sqrt(const F &x)
+        {
+            return (F)_mm256_sqrt_ps((__m256)x);
+        }
+
+#include "PhysicsBatchKernels.hh"
+    };
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#pragma GCC optimize("fp-contract=off")
+    namespace avx512
+    {
+        typedef float F __attribute__((vector_size(64)));
+        typedef int I __attribute__((vector_size(64)));
+
+        inline F Load(const float *x)
+        {
+            return (F)_mm512_loadu_ps(x);
+        }
+
+        inline void Store(float *out, const F &x)
+        {
+            _mm512_storeu_ps(out, (__m512)x);
+        }
+
+        inline F Sqrt(const F &x)
+        {
+            return (F)_mm512_sqrt_ps((__m512)x);
+        }
+
+#include "PhysicsBatchKernels.hh"
+    };
+#pragma GCC pop_options
+
+#endif
+
+    // the levels of the Float policy, by Physics::Batch::Level
+    const Kernels<float> FLOAT_KERNELS[] = {
+        scalar::KERNELS<Physics::Float>,
+#ifdef PHYSICS_BATCH_VECTOR
+        {avx2::GetPt, avx2::GetP, avx2::GetEkin, avx2::GetPhi, avx2::GetTheta, avx2::boostz, avx2::GetRapidity},
+        {avx512::GetPt, avx512::GetP, avx512::GetEkin, avx512::GetPhi, avx512::GetTheta, avx512::boostz, avx512::GetRapidity},
+#endif
+    };
+
+    Physics::Batch::Level &ActiveLevel()
+    {
+        static Physics::Batch::Level level = Physics::Batch::GetSupportedLevel();
+        return level;
+    }
+
+    template <typename P>
+    const Kernels<typename P::Real> &Active()
+    {
+        return scalar::KERNELS<P>;
+    }
+
+    template <>
+    const Kernels<float> &Active<Physics::Float>()
+    {
+        return FLOAT_KERNELS[ActiveLevel()];
+    }
+};
+
+Physics::Batch::Level Physics::Batch::GetSupportedLevel()
+{
+#ifdef PHYSICS_BATCH_VECTOR
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return AVX2;
+    }
+#endif
+    return Scalar;
+}
+
+Physics::Batch::Level Physics::Batch::GetLevel()
+{
+    return ActiveLevel();
+}
+
+void Physics::Batch::SetLevel(const Level &level)
+{
+    if (level > GetSupportedLevel())
+    {
+        std::string msg = Form("%s is not supported by this CPU.", GetLevelName(level).c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    ActiveLevel() = level;
+}
+
+std::string Physics::Batch::GetLevelName(const Level &level)
+{
+    switch (level)
+    {
+    case AVX2:
+        return "avx2";
+    case AVX512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
+
+template <typename P>
+void Physics::Batch::GetPt(const std::size_t &n, const typename P::Real *px, const typename P::Real *py, typename P::Real *pt)
+{
+    Active<P>().GetPt(n, px, py, pt);
+}
+
+template <typename P>
+void Physics::Batch::GetP(const std::size_t &n, const typename P::Real *pt, const typename P::Real *pz, typename P::Real *p)
+{
+    Active<P>().GetP(n, pt, pz, p);
+}
+
+template <typename P>
+void Physics::Batch::GetEkin(const std::size_t &n, const typename P::Real *mass, const typename P::Real *p, typename P::Real *ekin)
+{
+    Active<P>().GetEkin(n, mass, p, ekin);
+}
+
+template <typename P>
+void Physics::Batch::GetPhi(const std::size_t &n, const typename P::Real *px, const typename P::Real *py, typename P::Real *phi)
+{
+    Active<P>().GetPhi(n, px, py, phi);
+}
+
+template <typename P>
+void Physics::Batch::GetTheta(const std::size_t &n, const typename P::Real *pt, const typename P::Real *pz, typename P::Real *theta)
+{
+    Active<P>().GetTheta(n, pt, pz, theta);
+}
+
+template <typename P>
+void Physics::Batch::boostz(const std::size_t &n, const typename P::Real *mass, const typename P::Real *pz, const typename P::Real *ekin, const typename P::Real &betacms, const typename P::Real &gamma, typename P::Real *pz_boosted)
+{
+    Active<P>().boostz(n, mass, pz, ekin, betacms, gamma, pz_boosted);
+}
+
+template <typename P>
+void Physics::Batch::GetRapidity(const std::size_t &n, const typename P::Real *ekin, const typename P::Real *pz, const typename P::Real *mass, typename P::Real *rapidity)
+{
+    Active<P>().GetRapidity(n, ekin, pz, mass, rapidity);
+}
+
+// both policies, see Physics.hh
+template void Physics::Batch::GetPt<Physics::Float>(const std::size_t &n, const float *px, const float *py, float *pt);
+template void Physics::Batch::GetP<Physics::Float>(const std::size_t &n, const float *pt, const float *pz, float *p);
+template void Physics::Batch::GetEkin<Physics::Float>(const std::size_t &n, const float *mass, const float *p, float *ekin);
+template void Physics::Batch::GetPhi<Physics::Float>(const std::size_t &n, const float *px, const float *py, float *phi);
+template void Physics::Batch::GetTheta<Physics::Float>(const std::size_t &n, const float *pt, const float *pz, float *theta);
+template void Physics::Batch::boostz<Physics::Float>(const std::size_t &n, const float *mass, const float *pz, const float *ekin, const float &betacms, const float &gamma, float *pz_boosted);
+template void Physics::Batch::GetRapidity<Physics::Float>(const std::size_t &n, const float *ekin, const float *pz, const float *mass, float *rapidity);
+template void Physics::Batch::GetPt<Physics::Double>(const std::size_t &n, const double *px, const double *py, double *pt);
+template void Physics::Batch::GetP<Physics::Double>(const std::size_t &n, const double *pt, const double *pz, double *p);
+template void Physics::Batch::GetEkin<Physics::Double>(const std::size_t &n, const double *mass, const double *p, double *ekin);
+template void Physics::Batch::GetPhi<Physics::Double>(const std::size_t &n, const double *px, const double *py, double *phi);
+template void Physics::Batch::GetTheta<Physics::Double>(const std::size_t &n, const double *pt, const double *pz, double *theta);
+template void Physics::Batch::boostz<Physics::Double>(const std::size_t &n, const double *mass, const double *pz, const double *ekin, const double &betacms, const double &gamma, double *pz_boosted);
+template void Physics::Batch::GetRapidity<Physics::Double>(const std::size_t &n, const double *ekin, const double *pz, const double *mass, double *rapidity);
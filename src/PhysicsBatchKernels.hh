@@ -0,0 +1,171 @@
+// No include guard : included once per instruction set by PhysicsBatch.cpp, inside its #pragma GCC target, after the definitions of
+//  - F, I : vectors of W float / int32 lanes (GCC vector extensions),
+//  - Load(const float *) -> F, Store(float *, F) : W floats from / to the lanes,
+//  - Sqrt(F) : the hardware square root.
+// The functions below are the same for every set; only the width and the instructions differ.
+
+// natural log for normal x > 0; -inf at 0, NaN below, inf at inf. Range reduction to m in [sqrt(1/2), sqrt(2)) and the polynomial of Cephes logf
+inline F Log(const F &x)
+{
+    I bits = (I)x;
+    I e = ((bits >> 23) & 0xff) - 127;
+    F m = (F)((bits & 0x007fffff) | 0x3f800000);
+    I big = m > 1.41421356f;
+    m = big ? m * 0.5f : m;
+    e = e - big;
+
+    F f = m - 1.f;
+    F z = f * f;
+    F y = 7.0376836292e-2f * f - 1.1514610310e-1f;
+    y = y * f + 1.1676998740e-1f;
+    y = y * f - 1.2420140846e-1f;
+    y = y * f + 1.4249322787e-1f;
+    y = y * f - 1.6668057665e-1f;
+    y = y * f + 2.0000714765e-1f;
+    y = y * f - 2.4999993993e-1f;
+    y = y * f + 3.3333331174e-1f;
+    y = y * f * z;
+
+    F fe = __builtin_convertvector(e, F);
+    y = y - 2.12194440e-4f * fe;
+    y = y - 0.5f * z;
+    F result = f + y + 0.693359375f * fe;
+
+    const F inf = (F)(I{} + 0x7f800000);
+    result = (x == inf) ? inf : result;
+    result = (x == 0.f) ? -inf : result;
+    return (x >= 0.f) ? result : (F)(I{} + 0x7fc00000);
+}
+
+// log(1 + u), exact for small u by the correction of Log(1 + u) with the rounding of 1 + u
+inline F Log1p(const F &u)
+{
+    F w = 1.f + u;
+    F result = (w == 1.f) ? u : Log(w) * (u / (w - 1.f));
+    return (w == (F)(I{} + 0x7f800000)) ? w : result;
+}
+
+// atan2 with the conventions of TMath::ATan2, 0 at (0, 0); the polynomial of Cephes atanf on min(|x|, |y|) / max(|x|, |y|),
+// then moved to the octant of (x, y)
+inline F Atan2(const F &y, const F &x)
+{
+    const I sign = I{} + static_cast<int>(0x80000000u);
+    F ax = (F)((I)x & ~sign);
+    F ay = (F)((I)y & ~sign);
+    F lo = (ax < ay) ? ax : ay;
+    F hi = (ax < ay) ? ay : ax;
+    F a = (hi > 0.f) ? lo / hi : F{};
+
+    I reduce = a > 0.41421356f;
+    a = reduce ? (a - 1.f) / (a + 1.f) : a;
+    F z = a * a;
+    F r = 8.05374449538e-2f * z - 1.38776856032e-1f;
+    r = r * z + 1.99777106478e-1f;
+    r = r * z - 3.33329491539e-1f;
+    r = r * z * a + a;
+    r = reduce ? r + 0.78539816f : r;
+
+    r = (ay > ax) ? 1.57079633f - r : r;
+    r = (x < 0.f) ? 3.14159265f - r : r;
+    return (F)((I)r | ((I)y & sign));
+}
+
+// out[i] = kernel(in[0][i], ..., in[N - 1][i]); the tail goes through a zero-padded copy, so that every element has the same approximation
+template <int N, typename Kernel>
+inline void Map(const std::size_t &n, const std::array<const float *, N> &in, float *out, const Kernel &kernel)
+{
+    const std::size_t W = sizeof(F) / sizeof(float);
+    std::array<F, N> x;
+    std::size_t i = 0;
+    for (; i + W <= n; i += W)
+    {
+        for (int k = 0; k < N; k++)
+        {
+            x[k] = Load(in[k] + i);
+        }
+        Store(out + i, kernel(x));
+    }
+    if (i == n)
+    {
+        return;
+    }
+
+    float buffer[N][W] = {};
+    float result[W];
+    for (int k = 0; k < N; k++)
+    {
+        std::copy(in[k] + i, in[k] + n, buffer[k]);
+        x[k] = Load(buffer[k]);
+    }
+    Store(result, kernel(x));
+    std::copy(result, result + (n - i), out + i);
+}
+
+// the kernels of Map(), as functors : the body of a lambda would not be compiled for the instruction set of the #pragma
+struct Hypot
+{
+    F operator()(const std::array<F, 2> &x) const { return Sqrt(x[0] * x[0] + x[1] * x[1]); }
+};
+
+struct Ekin
+{
+    F operator()(const std::array<F, 2> &x) const
+    {
+        F p2 = x[1] * x[1];
+        F energy = Sqrt(p2 + x[0] * x[0]) + x[0];
+        return (energy > 0.f) ? p2 / energy : F{};
+    }
+};
+
+struct Angle
+{
+    // phi from (px, py), theta from (pt, pz)
+    bool theta;
+    F operator()(const std::array<F, 2> &x) const { return this->theta ? Atan2(x[0], x[1]) : Atan2(x[1], x[0]); }
+};
+
+struct Boost
+{
+    float betacms, gamma;
+    F operator()(const std::array<F, 3> &x) const { return this->gamma * (x[1] - this->betacms * (x[2] + x[0])); }
+};
+
+struct Rapidity
+{
+    F operator()(const std::array<F, 3> &x) const { return Log1p(2.f * x[1] / (x[0] - x[1] + x[2])) * 0.5f; }
+};
+
+void GetPt(const std::size_t &n, const float *px, const float *py, float *pt)
+{
+    Map<2>(n, {px, py}, pt, Hypot());
+}
+
+void GetP(const std::size_t &n, const float *pt, const float *pz, float *p)
+{
+    Map<2>(n, {pt, pz}, p, Hypot());
+}
+
+void GetEkin(const std::size_t &n, const float *mass, const float *p, float *ekin)
+{
+    Map<2>(n, {mass, p}, ekin, Ekin());
+}
+
+void GetPhi(const std::size_t &n, const float *px, const float *py, float *phi)
+{
+    Map<2>(n, {px, py}, phi, Angle{false});
+}
+
+void GetTheta(const std::size_t &n, const float *pt, const float *pz, float *theta)
+{
+    Map<2>(n, {pt, pz}, theta, Angle{true});
+}
+
+void boostz(const std::size_t &n, const float *mass, const float *pz, const float *ekin, const float &betacms, const float &gamma, float *pz_boosted)
+{
+    Map<3>(n, {mass, pz, ekin}, pz_boosted, Boost{betacms, gamma});
+}
+
+void GetRapidity(const std::size_t &n, const float *ekin, const float *pz, const float *mass, float *rapidity)
+{
+    Map<3>(n, {ekin, pz, mass}, rapidity, Rapidity());
+}
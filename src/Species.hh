@@ -0,0 +1,108 @@
+#ifndef Species_hh
+#define Species_hh
+
+#include <array>
+#include <string>
+
+/**
+ * @brief Compile-time registry of the particle species of the analysis, (Z, A) -> small integer ID.
+ *
+ * Detector cuts and histograms are indexed by the ID, the names are only used to name histograms and to read or write them.
+ */
+namespace Species
+{
+    enum ID : int
+    {
+        Unknown = -1,
+        Neutron,
+        Proton,
+        Deuteron,
+        Triton,
+        Helium3,
+        Helium4,
+        NumNuclei,
+        // pseudo-species summing the neutrons or protons carried by every particle, they have no (Z, A)
+        CoalescenceN = NumNuclei,
+        CoalescenceP,
+        NumSpecies,
+    };
+
+    struct Entry
+    {
+        int Z, A;
+        const char *name;
+    };
+
+    constexpr std::array<Entry, NumSpecies> TABLE = {{
+        {0, 1, "n"},
+        {1, 1, "p"},
+        {1, 2, "d"},
+        {1, 3, "t"},
+        {2, 3, "3He"},
+        {2, 4, "4He"},
+        {-1, -1, "coal_n"},
+        {-1, -1, "coal_p"},
+    }};
+
+    constexpr int TableZ()
+    {
+        int z = 0;
+        for (const auto &entry : TABLE)
+        {
+            z = (entry.Z + 1 > z) ? entry.Z + 1 : z;
+        }
+        return z;
+    }
+    constexpr int TableA()
+    {
+        int a = 0;
+        for (const auto &entry : TABLE)
+        {
+            a = (entry.A + 1 > a) ? entry.A + 1 : a;
+        }
+        return a;
+    }
+
+    // flat [Z][A] array of IDs, Unknown where (Z, A) is not in the registry
+    constexpr std::array<int, TableZ() * TableA()> BuildLookup()
+    {
+        std::array<int, TableZ() * TableA()> lookup = {};
+        for (auto &id : lookup)
+        {
+            id = Unknown;
+        }
+        for (int id = 0; id < NumNuclei; id++)
+        {
+            lookup[TABLE[id].Z * TableA() + TABLE[id].A] = id;
+        }
+        return lookup;
+    }
+    inline constexpr std::array<int, TableZ() * TableA()> LOOKUP = BuildLookup();
+
+    constexpr int GetID(const int &Z, const int &A)
+    {
+        bool in_table = (Z >= 0) & (Z < TableZ()) & (A >= 0) & (A < TableA());
+        return in_table ? LOOKUP[Z * TableA() + A] : Unknown;
+    }
+
+    inline int GetID(const std::string &name)
+    {
+        for (int id = 0; id < NumSpecies; id++)
+        {
+            if (name == TABLE[id].name)
+            {
+                return id;
+            }
+        }
+        return Unknown;
+    }
+
+    inline std::string GetName(const int &id)
+    {
+        return (id >= 0 && id < NumSpecies) ? TABLE[id].name : "";
+    }
+
+    static_assert(GetID(1, 1) == Proton && GetID(2, 4) == Helium4 && GetID(0, 0) == Unknown);
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef Tokenizer_hh
+#define Tokenizer_hh
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <charconv>
+#include <system_error>
+
+/**
+ * @brief Whitespace-separated number reader over a character range, e.g. a MappedFile.
+ *
+ * Replacement for `std::ifstream >>` on the AMD tables, locale-free and without allocation. std::from_chars rounds like
+ * the stream extraction, so the values are bit-identical. Read() returns false at the end of the range, or without moving
+ * if the next token is not a number or out of range; AtEnd() tells the two apart.
+ */
+class Tokenizer
+{
+public:
+    Tokenizer(const char *begin, const char *end) : mPos(begin), mEnd(end) {}
+
+    bool Read(int &value);
+    bool Read(double &value);
+
+    // skip the rest of the current line, e.g. a header
+    void SkipLine();
+    bool AtEnd();
+
+    const char *Position() const { return this->mPos; }
+    void SetPosition(const char *pos) { this->mPos = pos; }
+
+private:
+    void SkipSpace();
+    const char *mPos;
+    const char *mEnd;
+};
+
+inline void Tokenizer::SkipSpace()
+{
+    while (this->mPos != this->mEnd && (*this->mPos == ' ' || *this->mPos == '\n' || *this->mPos == '\t' || *this->mPos == '\r'))
+    {
+        this->mPos++;
+    }
+}
+
+inline bool Tokenizer::AtEnd()
+{
+    this->SkipSpace();
+    return this->mPos == this->mEnd;
+}
+
+inline void Tokenizer::SkipLine()
+{
+    const char *eol = static_cast<const char *>(std::memchr(this->mPos, '\n', this->mEnd - this->mPos));
+    this->mPos = (eol == nullptr) ? this->mEnd : eol + 1;
+}
+
+inline bool Tokenizer::Read(int &value)
+{
+    this->SkipSpace();
+    if (this->mPos != this->mEnd && *this->mPos == '+')
+    {
+        this->mPos++;
+    }
+    auto [ptr, ec] = std::from_chars(this->mPos, this->mEnd, value);
+    if (ec != std::errc())
+    {
+        return false;
+    }
+    this->mPos = ptr;
+    return true;
+}
+
+inline bool Tokenizer::Read(double &value)
+{
+    this->SkipSpace();
+    if (this->mPos != this->mEnd && *this->mPos == '+')
+    {
+        this->mPos++;
+    }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto [ptr, ec] = std::from_chars(this->mPos, this->mEnd, value);
+    if (ec != std::errc())
+    {
+        return false;
+    }
+    this->mPos = ptr;
+#else
+    // floating-point from_chars requires GCC 11; copy the token so strtod never reads past the mapping
+    char buffer[64];
+    std::size_t length = 0;
+    while (this->mPos + length != this->mEnd && length < sizeof(buffer) - 1 && this->mPos[length] > ' ')
+    {
+        buffer[length] = this->mPos[length];
+        length++;
+    }
+    buffer[length] = '\0';
+    char *ptr;
+    errno = 0;
+    value = std::strtod(buffer, &ptr);
+    if (ptr == buffer || errno == ERANGE)
+    {
+        return false;
+    }
+    this->mPos += ptr - buffer;
+#endif
+    return true;
+}
+
+#endif
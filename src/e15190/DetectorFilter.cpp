@@ -0,0 +1,162 @@
+#include "DetectorFilter.hh"
+
+void DetectorFilter::Fill(const FilterParticles &particles, DetectorHits &hits)
+{
+    std::array<uint8_t, FilterParticles::MAX_MULTI> mask;
+    this->Accept(particles, mask.data());
+
+    this->Reset();
+    for (std::size_t i = 0; i < particles.n; i++)
+    {
+        if (!mask[i])
+        {
+            continue;
+        }
+        int multi = this->GetMulti();
+        hits.N[multi] = particles.N[i];
+        hits.Z[multi] = particles.Z[i];
+        hits.px[multi] = particles.px[i];
+        hits.py[multi] = particles.py[i];
+        hits.pz[multi] = particles.pz_lab[i];
+        this->AddHit(particles, i);
+    }
+    hits.multi = this->GetMulti();
+}
+
+void MicroballFilter::Prepare(FilterParticles &particles)
+{
+    for (std::size_t i = 0; i < particles.n; i++)
+    {
+        double phi_deg = particles.phi[i] * TMath::RadToDeg();
+        int ring = this->mMicroball->GetRingID(particles.theta_deg[i]);
+        if (ring == -1)
+        {
+            continue;
+        }
+        if (phi_deg < this->mMicroball->GetPhiMinInRing(ring))
+        {
+            particles.phi[i] += 2. * TMath::Pi();
+        }
+        if (phi_deg > this->mMicroball->GetPhiMaxInRing(ring))
+        {
+            particles.phi[i] -= 2. * TMath::Pi();
+        }
+    }
+}
+
+void MicroballFilter::Accept(const FilterParticles &particles, uint8_t *mask) const
+{
+    this->mMicroball->Accept(particles.n, particles.A.data(), particles.Z.data(), particles.theta_deg.data(), particles.phi_deg.data(), particles.kinergy_lab.data(), mask);
+}
+
+void HiRAFilter::Accept(const FilterParticles &particles, uint8_t *mask) const
+{
+    this->mHiRA->Accept(particles.n, particles.A.data(), particles.Z.data(), particles.theta_deg.data(), particles.phi_deg.data(), particles.kinergy_lab.data(), mask);
+}
+
+FilterPipeline::FilterPipeline(const FilterPipeline &other)
+{
+    // the statistics of the evaluation order start over, every copy orders its detectors on its own events
+    this->mNextReorder = ReorderInterval;
+    for (const auto &stage : other.mStages)
+    {
+        this->Add(stage.detector->Clone(), stage.min_hits);
+    }
+}
+
+FilterPipeline::~FilterPipeline()
+{
+    for (auto &stage : this->mStages)
+    {
+        delete stage.detector;
+    }
+}
+
+void FilterPipeline::Add(DetectorFilter *detector, const int &min_hits)
+{
+    if (this->Find(detector->GetPrefix()) != -1)
+    {
+        std::string msg = Form("detector %s is already in the filter.", detector->GetPrefix().c_str());
+        delete detector;
+        throw std::invalid_argument(msg.c_str());
+    }
+    this->mStages.push_back({detector, min_hits, 0, 0});
+
+    // the detectors without a requirement are only filled for the events that pass, in the order they were added
+    this->mOrder.clear();
+    for (int pass : {1, 0})
+    {
+        for (std::size_t i = 0; i < this->mStages.size(); i++)
+        {
+            if ((this->mStages[i].min_hits > 0) == pass)
+            {
+                this->mOrder.push_back(i);
+            }
+        }
+    }
+}
+
+int FilterPipeline::Find(const std::string &prefix) const
+{
+    for (std::size_t i = 0; i < this->mStages.size(); i++)
+    {
+        if (this->mStages[i].detector->GetPrefix() == prefix)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void FilterPipeline::Prepare(FilterParticles &particles)
+{
+    for (auto &stage : this->mStages)
+    {
+        stage.detector->Prepare(particles);
+    }
+    for (std::size_t i = 0; i < particles.n; i++)
+    {
+        particles.phi_deg[i] = particles.phi[i] * TMath::RadToDeg();
+    }
+}
+
+bool FilterPipeline::Filter(FilterParticles &particles, std::vector<DetectorHits> &hits)
+{
+    this->Prepare(particles);
+    hits.resize(this->mStages.size());
+
+    if (--this->mNextReorder == 0)
+    {
+        this->Reorder();
+        this->mNextReorder = ReorderInterval;
+    }
+    for (const auto &i : this->mOrder)
+    {
+        Stage &stage = this->mStages[i];
+        stage.detector->Fill(particles, hits[i]);
+        if (stage.min_hits > 0)
+        {
+            stage.nseen++;
+            if (hits[i].multi < stage.min_hits)
+            {
+                stage.nrejected++;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void FilterPipeline::Reorder()
+{
+    // most selective requirement first; the detectors without one stay at the end
+    auto rejection = [this](const int &i)
+    {
+        const Stage &stage = this->mStages[i];
+        return stage.nseen > 0 ? static_cast<double>(stage.nrejected) / stage.nseen : 0.;
+    };
+    auto last_gated = std::partition_point(this->mOrder.begin(), this->mOrder.end(), [this](const int &i)
+                                           { return this->mStages[i].min_hits > 0; });
+    std::stable_sort(this->mOrder.begin(), last_gated, [&rejection](const int &a, const int &b)
+                     { return rejection(a) > rejection(b); });
+}
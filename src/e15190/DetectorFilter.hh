@@ -0,0 +1,157 @@
+#ifndef DetectorFilter_hh
+#define DetectorFilter_hh
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+
+#include "TMath.h"
+#include "TString.h"
+#include "Microball.hh"
+#include "HiRA.hh"
+
+/**
+ * @brief Lab-frame quantities of the particles of one event as arrays, shared by the detectors of a FilterPipeline.
+ *
+ * phi is in radians as computed by Particle; the pipeline fills phi_deg after every detector has shifted phi into its
+ * own convention.
+ */
+struct FilterParticles
+{
+    static const int MAX_MULTI = 128;
+    std::size_t n = 0;
+    std::array<int, MAX_MULTI> N, Z, A;
+    std::array<double, MAX_MULTI> px, py, pz_lab;
+    std::array<double, MAX_MULTI> theta_deg, phi, phi_deg, kinergy_lab;
+};
+
+/**
+ * @brief Particles seen by one detector in one event, written to the `<prefix>_*` branches of the filtered tree.
+ */
+struct DetectorHits
+{
+    static const int MAX_MULTI = 128;
+    int multi;
+    std::array<int, MAX_MULTI> N, Z;
+    std::array<double, MAX_MULTI> px, py, pz;
+};
+
+/**
+ * @brief One detector of the filter.
+ *
+ * Accept() evaluates all particles of an event at once. The accepted ones are then counted in order, each into slot
+ * GetMulti() of the hits before AddHit(), so that a detector can merge particles into one hit, as Microball does for one CsI.
+ */
+class DetectorFilter
+{
+public:
+    DetectorFilter(const std::string &prefix) { this->mPrefix = prefix; }
+    virtual ~DetectorFilter() { ; }
+    virtual DetectorFilter *Clone() const = 0;
+
+    const std::string &GetPrefix() const { return this->mPrefix; }
+
+    // shift the angles into the convention of the detector, called for every detector before any Accept()
+    virtual void Prepare(FilterParticles &) { ; }
+    virtual void Accept(const FilterParticles &particles, uint8_t *mask) const = 0;
+
+    virtual void Reset() = 0;
+    virtual int GetMulti() = 0;
+    virtual void AddHit(const FilterParticles &particles, const std::size_t &i) = 0;
+
+    // Accept() and count the particles of one event into hits
+    void Fill(const FilterParticles &particles, DetectorHits &hits);
+
+private:
+    std::string mPrefix;
+};
+
+/**
+ * @brief Microball, branches `uball_*`; the multiplicity is the number of CsI hit.
+ */
+class MicroballFilter : public DetectorFilter
+{
+public:
+    MicroballFilter(Microball *microball) : DetectorFilter("uball") { this->mMicroball = microball; }
+    ~MicroballFilter() { delete this->mMicroball; }
+    DetectorFilter *Clone() const { return new MicroballFilter(new Microball(*this->mMicroball)); }
+
+    // phi is calculated according to microball detector, if the particle is not covered by microball, phi is not correct
+    // and should be in the range of [-pi, pi].
+    void Prepare(FilterParticles &particles);
+    void Accept(const FilterParticles &particles, uint8_t *mask) const;
+
+    void Reset() { this->mMicroball->ResetCsIHitMap(); }
+    int GetMulti() { return this->mMicroball->GetCsIHits(); }
+    void AddHit(const FilterParticles &particles, const std::size_t &i) { this->mMicroball->AddCsIHit(particles.theta_deg[i], particles.phi_deg[i]); }
+
+private:
+    Microball *mMicroball;
+};
+
+/**
+ * @brief HiRA, branches `hira_*`.
+ */
+class HiRAFilter : public DetectorFilter
+{
+public:
+    HiRAFilter(HiRA *hira) : DetectorFilter("hira") { this->mHiRA = hira; }
+    ~HiRAFilter() { delete this->mHiRA; }
+    DetectorFilter *Clone() const { return new HiRAFilter(new HiRA(*this->mHiRA)); }
+
+    void Accept(const FilterParticles &particles, uint8_t *mask) const;
+
+    void Reset() { this->mHiRA->ResetCounter(); }
+    int GetMulti() { return this->mHiRA->GetCountPass(); }
+    void AddHit(const FilterParticles &, const std::size_t &) { this->mHiRA->CountPass(); }
+
+private:
+    HiRA *mHiRA;
+};
+
+/**
+ * @brief Detectors of the filter, evaluated in one pass over each event.
+ *
+ * The hits of detector i go to hits[i], in the order the detectors were added. An event with fewer than min_hits hits in a
+ * detector is rejected; those detectors are evaluated first, the most rejecting one first, the others only for the events
+ * that pass. The order does not change the result.
+ */
+class FilterPipeline
+{
+public:
+    FilterPipeline() { this->mNextReorder = ReorderInterval; }
+    FilterPipeline(const FilterPipeline &other);
+    FilterPipeline &operator=(const FilterPipeline &) = delete;
+    ~FilterPipeline();
+
+    // takes ownership of detector
+    void Add(DetectorFilter *detector, const int &min_hits);
+    std::size_t Size() const { return this->mStages.size(); }
+    DetectorFilter *GetDetector(const std::size_t &i) const { return this->mStages[i].detector; }
+    // index of the detector with this prefix, -1 if there is none
+    int Find(const std::string &prefix) const;
+
+    // shift the angles of the particles for every detector and fill phi_deg
+    void Prepare(FilterParticles &particles);
+    // false if the event is rejected, the hits are then incomplete
+    bool Filter(FilterParticles &particles, std::vector<DetectorHits> &hits);
+
+private:
+    static constexpr long ReorderInterval = 1024;
+    struct Stage
+    {
+        DetectorFilter *detector;
+        int min_hits;
+        long nseen, nrejected;
+    };
+    void Reorder();
+
+    std::vector<Stage> mStages;
+    std::vector<int> mOrder; // evaluation order, the stages with min_hits > 0 first
+    long mNextReorder;
+};
+
+#endif
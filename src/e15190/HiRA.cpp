@@ -5,9 +5,29 @@ HiRA::HiRA()
     mKinergyCut = this->KINERGYCUT;
     mThetaCut = this->THETACUT;
     mPhiCut = this->PHICUT;
-    mMassChargeToName = this->MASS_CHARGE_TO_NAME;
+    mAnalParticle.fill(false);
+    for (const auto &species : this->ANAL_PARTICLES)
+    {
+        mAnalParticle[species] = true;
+    }
     mCounterPass = 0;
     mCounterFail = 0;
+    this->BuildKinergyCutTable();
+}
+
+void HiRA::BuildKinergyCutTable()
+{
+    mKinergyCutLow.fill(INFINITY);
+    mKinergyCutHigh.fill(-INFINITY);
+    for (const auto &[species, cut] : mKinergyCut)
+    {
+        if (species < 0 || species >= Species::NumSpecies || !mAnalParticle[species])
+        {
+            continue;
+        }
+        mKinergyCutLow[species] = cut[0];
+        mKinergyCutHigh[species] = cut[1];
+    }
 }
 
 bool HiRA::PassAngularCut(const double &theta_deg, const double &phi_deg)
@@ -17,16 +37,26 @@ bool HiRA::PassAngularCut(const double &theta_deg, const double &phi_deg)
         phi_deg >= mPhiCut[0] && phi_deg <= mPhiCut[1]);
 }
 
-bool HiRA::PassKinergyCut(const std::string &particle_name, const double &kinergy_per_nucleon)
+bool HiRA::PassKinergyCut(const int &species, const double &kinergy_per_nucleon)
 {
-    return this->mKinergyCut.count(particle_name) == 1 && kinergy_per_nucleon >= this->mKinergyCut[particle_name][0] && kinergy_per_nucleon <= this->mKinergyCut[particle_name][1];
+    int index = this->KinergyCutIndex(species);
+    return kinergy_per_nucleon >= mKinergyCutLow[index] && kinergy_per_nucleon <= mKinergyCutHigh[index];
 }
 
 bool HiRA::PassKinergyCut(const int &A, const int &Z, const double &kinergy)
 {
-    if (mMassChargeToName.count({A, Z}) == 0)
+    return this->PassKinergyCut(Species::GetID(Z, A), kinergy / A);
+}
+
+void HiRA::Accept(const std::size_t &n, const int *A, const int *Z, const double *theta_deg, const double *phi_deg, const double *kinergy, uint8_t *mask) const
+{
+    // same cuts as PassAngularCut, PassCharged and PassKinergyCut, without branches so that the loop vectorizes
+    for (std::size_t i = 0; i < n; i++)
     {
-        return false;
+        int index = this->KinergyCutIndex(Species::GetID(Z[i], A[i]));
+        double kinergy_per_nucleon = kinergy[i] / A[i];
+        bool pass_angle = (theta_deg[i] >= mThetaCut[0]) & (theta_deg[i] <= mThetaCut[1]) & (phi_deg[i] >= mPhiCut[0]) & (phi_deg[i] <= mPhiCut[1]);
+        bool pass_kinergy = (kinergy_per_nucleon >= mKinergyCutLow[index]) & (kinergy_per_nucleon <= mKinergyCutHigh[index]);
+        mask[i] = pass_angle & (Z[i] > 0) & pass_kinergy;
     }
-    return PassKinergyCut(mMassChargeToName[{A, Z}], kinergy / A);
 }
\ No newline at end of file
@@ -5,30 +5,37 @@
 #include <fstream>
 #include <array>
 #include <map>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
 #include <filesystem>
 namespace fs = std::filesystem;
 
 #include "TMath.h"
 #include "TString.h"
+#include "Species.hh"
 
 class HiRA
 {
 protected:
-    // kinergy cut for experiment e15190
-    std::map<std::string, std::array<double, 2>> KINERGYCUT = {
-        {"p", {20.0, 198.0}},
-        {"d", {15.0, 263.0 / 2}},
-        {"t", {12.0, 312 / 3.}},
-        {"3He", {20.0, 200.0}},
-        {"4He", {18.0, 200.0}},
+    // kinergy cut per nucleon for experiment e15190
+    std::map<int, std::array<double, 2>> KINERGYCUT = {
+        {Species::Proton, {20.0, 198.0}},
+        {Species::Deuteron, {15.0, 263.0 / 2}},
+        {Species::Triton, {12.0, 312 / 3.}},
+        {Species::Helium3, {20.0, 200.0}},
+        {Species::Helium4, {18.0, 200.0}},
     };
 
-    std::map<std::pair<int, int>, std::string> MASS_CHARGE_TO_NAME = {
-        {{1, 1}, "p"},
-        {{2, 1}, "d"},
-        {{3, 1}, "t"},
-        {{3, 2}, "3He"},
-        {{4, 2}, "4He"},
+    std::vector<int> ANAL_PARTICLES = {
+        Species::Proton,
+        Species::Deuteron,
+        Species::Triton,
+        Species::Helium3,
+        Species::Helium4,
     };
     std::array<double, 2> THETACUT = {30., 75.};
     std::array<double, 2> PHICUT = {-360, 360};
@@ -37,12 +44,19 @@ public:
     HiRA();
     ~HiRA(){};
     bool PassCharged(const int &Z) { return Z > 0; }
-    bool PassKinergyCut(const std::string &particle_name, const double &kinergy_per_nucleon);
+    bool PassKinergyCut(const int &species, const double &kinergy_per_nucleon);
     bool PassKinergyCut(const int &A, const int &Z, const double &kinergy);
+    bool PassKinergyCut(const std::string &particle_name, const double &kinergy_per_nucleon) { return this->PassKinergyCut(Species::GetID(particle_name), kinergy_per_nucleon); }
     bool PassAngularCut(const double &theta_deg, const double &phi_deg);
 
-    void AddAnalParticle(const int &Z, const int &A, const std::string &name) { this->mMassChargeToName[{A, Z}] = name; }
-    void SetKinergyCut(const std::string &, const double &, const double &);
+    // angular, charge and kinergy cuts of n particles at once, mask[i] = 1 if particle i passes all of them
+    void Accept(const std::size_t &n, const int *A, const int *Z, const double *theta_deg, const double *phi_deg, const double *kinergy, uint8_t *mask) const;
+
+    void AddAnalParticle(const int &species);
+    void SetKinergyCut(const int &species, const double &, const double &);
+    // by name, the (Z, A) and names of Species::TABLE
+    void AddAnalParticle(const int &Z, const int &A, const std::string &name);
+    void SetKinergyCut(const std::string &name, const double &, const double &);
     void SetThetaCut(const double &, const double &);
     void SetPhiCut(const double &, const double &);
 
@@ -54,13 +68,58 @@ public:
 
 private:
     long mCounterPass, mCounterFail;
-    std::map<std::string, std::array<double, 2>> mKinergyCut;
+    std::map<int, std::array<double, 2>> mKinergyCut;
     std::array<double, 2> mThetaCut;
     std::array<double, 2> mPhiCut;
-    std::map<std::pair<int, int>, std::string> mMassChargeToName;
+    std::array<bool, Species::NumSpecies> mAnalParticle;
+
+    // kinergy cut per nucleon indexed by Species::ID, rebuilt from mKinergyCut and mAnalParticle whenever they change,
+    // followed by one entry that rejects every kinergy, used for species without a cut and outside of the registry
+    std::array<double, Species::NumSpecies + 1> mKinergyCutLow;
+    std::array<double, Species::NumSpecies + 1> mKinergyCutHigh;
+    void BuildKinergyCutTable();
+    static int KinergyCutIndex(const int &species)
+    {
+        bool in_table = (species >= 0) & (species < Species::NumSpecies);
+        return in_table ? species : Species::NumSpecies;
+    }
 };
 
-inline void HiRA::SetKinergyCut(const std::string &name, const double &a, const double &b) { mKinergyCut[name] = {a, b}; }
+inline void HiRA::SetKinergyCut(const int &species, const double &a, const double &b)
+{
+    mKinergyCut[species] = {a, b};
+    this->BuildKinergyCutTable();
+}
+inline void HiRA::AddAnalParticle(const int &species)
+{
+    if (species < 0 || species >= Species::NumNuclei)
+    {
+        std::string msg = Form("HiRA::AddAnalParticle: species %d is not a nucleus of the registry", species);
+        throw std::invalid_argument(msg.c_str());
+    }
+    this->mAnalParticle[species] = true;
+    this->BuildKinergyCutTable();
+}
+inline void HiRA::AddAnalParticle(const int &Z, const int &A, const std::string &name)
+{
+    int species = Species::GetID(Z, A);
+    if (species == Species::Unknown || Species::GetID(name) != species)
+    {
+        std::string msg = Form("HiRA::AddAnalParticle: (Z, A) = (%d, %d) named %s is not a nucleus of the registry", Z, A, name.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    this->AddAnalParticle(species);
+}
+inline void HiRA::SetKinergyCut(const std::string &name, const double &a, const double &b)
+{
+    int species = Species::GetID(name);
+    if (species == Species::Unknown)
+    {
+        std::string msg = Form("HiRA::SetKinergyCut: no species %s in the registry", name.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    this->SetKinergyCut(species, a, b);
+}
 inline void HiRA::SetThetaCut(const double &a, const double &b) { mThetaCut = {a, b}; }
 inline void HiRA::SetPhiCut(const double &a, const double &b) { mPhiCut = {a, b}; }
 
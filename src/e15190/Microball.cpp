@@ -6,91 +6,270 @@ Microball::Microball()
     this->Is_apply_cut_multiple_hit = 1;
     this->Is_apply_cut_kinergy = 1;
     this->Is_apply_cut_coverage = 1;
+    this->KinergyThresholdTable.assign(1, MissingThreshold);
+    this->ResetCsIHitMap();
 }
 
-void Microball::ReadGeometryMap(const std::string &filename)
+void MicroballDatabase::ReadConfig(const std::string &filename)
+{
+    if (!fs::exists(filename))
+    {
+        std::string msg = Form("file does not exist : %s", filename.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    this->files.push_back(filename);
+    std::ifstream stream(filename.c_str());
+    stream.ignore(99, '\n');
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        std::istringstream iss(line);
+        std::string sys;
+        int ring_id, det_id;
+        if (!(iss >> sys >> ring_id))
+        {
+            continue;
+        }
+
+        std::vector<int> &det_ids = this->setups[sys][ring_id];
+        det_ids.clear();
+        while (iss >> det_id)
+        {
+            det_ids.push_back(det_id);
+        }
+    }
+}
+
+void MicroballDatabase::ReadGeometry(const std::string &filename)
 {
     if (!fs::exists(filename))
     {
         std::string msg = Form("file does not exist : %s", filename.c_str());
         throw std::invalid_argument(msg.c_str());
     }
+    this->files.push_back(filename);
     std::ifstream infile(filename.c_str());
     infile.ignore(99, '\n');
 
-    int ring, det;
-    double theta1, theta2, phi1, phi2;
-    while (infile >> ring)
+    GeometryRow row;
+    while (infile >> row.ring >> row.det >> row.theta_min >> row.theta_max >> row.phi_min >> row.phi_max)
+    {
+        this->geometry.push_back(row);
+    }
+}
+
+void MicroballDatabase::ReadThreshold(const std::string &filename)
+{
+    if (!fs::exists(filename))
+    {
+        std::string msg = Form("file does not exist : %s", filename.c_str());
+        throw std::invalid_argument(msg.c_str());
+    }
+    this->files.push_back(filename);
+    std::ifstream infile(filename.c_str());
+    infile.ignore(99, '\n');
+
+    ThresholdRow row;
+    while (infile >> row.ring >> row.A >> row.Z >> row.kinergy)
+    {
+        this->thresholds.push_back(row);
+    }
+}
+
+void Microball::ReadGeometryMap(const std::string &filename)
+{
+    MicroballDatabase database;
+    database.ReadGeometry(filename);
+    this->ReadGeometryMap(database);
+}
+
+void Microball::ReadGeometryMap(const MicroballDatabase &database)
+{
+    for (const auto &row : database.geometry)
     {
-        infile >> det >> theta1 >> theta2 >> phi1 >> phi2;
-        if (this->DetectorSetupMap.count(ring) == 1)
+        if (this->DetectorSetupMap.count(row.ring) == 1)
         {
-            this->ThetaMap[ring] = {theta1, theta2};
-            if (std::find(this->DetectorSetupMap[ring].begin(), this->DetectorSetupMap[ring].end(), det) == this->DetectorSetupMap[ring].end())
+            this->ThetaMap[row.ring] = {row.theta_min, row.theta_max};
+            const std::vector<int> &det_ids = this->DetectorSetupMap[row.ring];
+            if (std::find(det_ids.begin(), det_ids.end(), row.det) == det_ids.end())
             {
                 continue;
             }
-            this->PhiMap[{ring, det}] = {phi1, phi2};
+            this->PhiMap[{row.ring, row.det}] = {row.phi_min, row.phi_max};
         }
     }
-    infile.close();
+    this->BuildAngularLookup();
 }
 
-void Microball::ConfigurateSetup(const std::string &reaction, const std::string &filename)
+void Microball::BuildAngularLookup()
 {
-    if (!fs::exists(filename))
+    auto by_low = [](const Interval &a, const Interval &b)
     {
-        std::string msg = Form("file does not exist : %s", filename.c_str());
-        throw std::invalid_argument(msg.c_str());
+        return a.low < b.low;
+    };
+
+    this->RingIntervals.clear();
+    for (const auto &[ring, theta_range] : this->ThetaMap)
+    {
+        if (ring < 0 || ring >= NumRing)
+        {
+            std::string msg = Form("ring %d is out of range [0, %d)", ring, NumRing);
+            throw std::invalid_argument(msg.c_str());
+        }
+        this->RingIntervals.push_back({theta_range[0], theta_range[1], ring});
     }
-    std::ifstream stream(filename.c_str());
-    stream.ignore(99, '\n');
-    std::string line;
-    while (std::getline(stream, line))
+    std::sort(this->RingIntervals.begin(), this->RingIntervals.end(), by_low);
+
+    this->PhiMinInRing.fill(DBL_MAX);
+    this->PhiMaxInRing.fill(DBL_MIN);
+    for (auto &intervals : this->DetIntervals)
     {
-        std::istringstream iss(line);
-        std::string sys;
-        int ring_id, det_id;
-        iss >> sys >> ring_id;
-        if (sys != reaction)
+        intervals.clear();
+    }
+    for (const auto &[ring_det, phi_range] : this->PhiMap)
+    {
+        int ring = ring_det[0];
+        if (ring_det[1] < 0 || ring_det[1] > NumDet)
         {
-            continue;
+            std::string msg = Form("detector %d of ring %d is out of range [0, %d]", ring_det[1], ring, NumDet);
+            throw std::invalid_argument(msg.c_str());
         }
+        this->DetIntervals[ring].push_back({phi_range[0], phi_range[1], ring_det[1]});
+        this->PhiMinInRing[ring] = std::min(this->PhiMinInRing[ring], phi_range[0]);
+        this->PhiMaxInRing[ring] = std::max(this->PhiMaxInRing[ring], phi_range[1]);
+    }
+    for (auto &intervals : this->DetIntervals)
+    {
+        std::sort(intervals.begin(), intervals.end(), by_low);
+    }
 
-        this->DetectorSetupMap[ring_id] = std::vector<int>();
-        while (iss >> det_id)
+    this->RingGrid = BuildGrid(this->RingIntervals);
+    for (int ring = 0; ring < NumRing; ring++)
+    {
+        this->DetGrids[ring] = BuildGrid(this->DetIntervals[ring]);
+    }
+}
+
+Microball::IntervalGrid Microball::BuildGrid(const std::vector<Interval> &intervals)
+{
+    IntervalGrid grid;
+    if (intervals.empty())
+    {
+        return grid;
+    }
+    double low = intervals.front().low;
+    double high = low;
+    for (const auto &interval : intervals)
+    {
+        high = std::max(high, interval.high);
+    }
+    grid.origin = low;
+    // one cell more than needed, so that the last interval boundary never falls on the end of the grid
+    grid.cells.resize((int)std::ceil((high - low) / IntervalGrid::CellWidth) + 1);
+
+    for (std::size_t icell = 0; icell < grid.cells.size(); icell++)
+    {
+        double cell_low = low + icell * IntervalGrid::CellWidth;
+        double cell_high = cell_low + IntervalGrid::CellWidth;
+        // boundaries on the edges of the cell split it as well, a value next to an edge may be rounded into either cell
+        bool split = false;
+        for (const auto &interval : intervals)
         {
-            this->DetectorSetupMap[ring_id].push_back(det_id);
+            split |= (interval.low >= cell_low && interval.low <= cell_high) || (interval.high >= cell_low && interval.high <= cell_high);
         }
+        grid.cells[icell] = split ? IntervalGrid::Split : FindInterval(intervals, cell_low);
     }
-    return;
+    return grid;
 }
 
-void Microball::ReadThresholdKinergyMap(const std::string &filename)
+int Microball::FindInterval(const std::vector<Interval> &intervals, const IntervalGrid &grid, const double &value)
 {
-    if (!fs::exists(filename))
+    double cell = (value - grid.origin) * (1. / IntervalGrid::CellWidth);
+    if (!(cell >= 0. && cell < grid.cells.size()))
     {
-        std::string msg = Form("file does not exist : %s", filename.c_str());
-        throw std::invalid_argument(msg.c_str());
+        // below or above every interval, or NaN
+        return -1;
     }
-    std::ifstream infile(filename.c_str());
-    infile.ignore(99, '\n');
+    int id = grid.cells[(std::size_t)cell];
+    return (id == IntervalGrid::Split) ? FindInterval(intervals, value) : id;
+}
+
+int Microball::FindInterval(const std::vector<Interval> &intervals, const double &value)
+{
+    // last interval starting at or before value
+    auto it = std::upper_bound(intervals.begin(), intervals.end(), value, [](const double &v, const Interval &interval)
+                               { return v < interval.low; });
+    if (it == intervals.begin())
+    {
+        return -1;
+    }
+    --it;
+    return (value < it->high) ? it->id : -1;
+}
+
+void Microball::ConfigurateSetup(const std::string &reaction, const std::string &filename)
+{
+    MicroballDatabase database;
+    database.ReadConfig(filename);
+    this->ConfigurateSetup(reaction, database);
+}
+
+void Microball::ConfigurateSetup(const std::string &reaction, const MicroballDatabase &database)
+{
+    if (database.setups.count(reaction) == 0)
+    {
+        return;
+    }
+    for (const auto &[ring_id, det_ids] : database.setups.at(reaction))
+    {
+        this->DetectorSetupMap[ring_id] = det_ids;
+    }
+}
 
-    int ring, A, Z;
-    double kinergy_MeV;
-    while (infile >> ring)
+void Microball::ReadThresholdKinergyMap(const std::string &filename)
+{
+    MicroballDatabase database;
+    database.ReadThreshold(filename);
+    this->ReadThresholdKinergyMap(database);
+}
+
+void Microball::ReadThresholdKinergyMap(const MicroballDatabase &database)
+{
+    for (const auto &[ring, A, Z, kinergy_MeV] : database.thresholds)
     {
         if (this->DetectorSetupMap.count(ring) == 0)
         {
             continue;
         }
-        infile >> A >> Z >> kinergy_MeV;
-        if (A > this->MaxA || Z > this->MaxZ)
+        if (A > this->MaxA || Z > this->MaxZ || A < 0 || Z < 0 || ring < 0 || ring >= NumRing)
         {
             continue;
         }
         this->KinergyThresholdMap[{ring, A, Z}] = kinergy_MeV;
     }
+
+    this->ThresholdTableMaxA = -1;
+    this->ThresholdTableMaxZ = -1;
+    for (const auto &[ring_A_Z, _] : this->KinergyThresholdMap)
+    {
+        this->ThresholdTableMaxA = std::max(this->ThresholdTableMaxA, ring_A_Z[1]);
+        this->ThresholdTableMaxZ = std::max(this->ThresholdTableMaxZ, ring_A_Z[2]);
+    }
+    this->KinergyThresholdTable.assign(NumRing * (this->ThresholdTableMaxA + 1) * (this->ThresholdTableMaxZ + 1) + 1, MissingThreshold);
+    for (const auto &[ring_A_Z, kinergy] : this->KinergyThresholdMap)
+    {
+        int index = (ring_A_Z[0] * (this->ThresholdTableMaxA + 1) + ring_A_Z[1]) * (this->ThresholdTableMaxZ + 1) + ring_A_Z[2];
+        this->KinergyThresholdTable[index] = kinergy;
+    }
+}
+
+double Microball::LookupThreshold(const int &ring, const int &aid, const int &zid) const
+{
+    if (ring < 0 || ring >= NumRing || aid < 0 || aid > this->ThresholdTableMaxA || zid < 0 || zid > this->ThresholdTableMaxZ)
+    {
+        return MissingThreshold;
+    }
+    return this->KinergyThresholdTable[(ring * (this->ThresholdTableMaxA + 1) + aid) * (this->ThresholdTableMaxZ + 1) + zid];
 }
 
 /*
@@ -175,31 +354,17 @@ std::pair<int, int> Microball::GetRingDetID(const double &thetalab, const double
     {
         return {-1, -1};
     }
-
-    for (const auto &[ring_det, phi_range] : this->PhiMap)
+    int det_id = FindInterval(this->DetIntervals[ring_id], this->DetGrids[ring_id], phi);
+    if (det_id == -1)
     {
-        if (ring_det[0] != ring_id)
-        {
-            continue;
-        }
-        if (phi >= phi_range[0] && phi < phi_range[1])
-        {
-            return {ring_det[0], ring_det[1]};
-        }
+        return {-1, -1};
     }
-    return {-1, -1};
+    return {ring_id, det_id};
 }
 
 int Microball::GetRingID(const double &thetalab)
 {
-    for (auto &[ring, theta_range] : this->ThetaMap)
-    {
-        if (thetalab >= theta_range[0] && thetalab < theta_range[1])
-        {
-            return ring;
-        }
-    }
-    return -1;
+    return FindInterval(this->RingIntervals, this->RingGrid, thetalab);
 }
 
 int Microball::GetDetID(const double &thetalab, const double &phi)
@@ -209,28 +374,12 @@ int Microball::GetDetID(const double &thetalab, const double &phi)
 
 double Microball::GetPhiMinInRing(const int &ring)
 {
-    double phi_min = DBL_MAX;
-    for (const auto &[ring_det, phi_range] : this->PhiMap)
-    {
-        if (ring_det[0] == ring && phi_range[0] < phi_min)
-        {
-            phi_min = phi_range[0];
-        }
-    }
-    return phi_min;
+    return (ring >= 0 && ring < NumRing) ? this->PhiMinInRing[ring] : DBL_MAX;
 }
 
 double Microball::GetPhiMaxInRing(const int &ring)
 {
-    double phi_max = DBL_MIN;
-    for (const auto &[ring_det, phi_range] : this->PhiMap)
-    {
-        if (ring_det[0] == ring && phi_range[1] > phi_max)
-        {
-            phi_max = phi_range[1];
-        }
-    }
-    return phi_max;
+    return (ring >= 0 && ring < NumRing) ? this->PhiMaxInRing[ring] : DBL_MIN;
 }
 
 double Microball::GetThresholdKinergy(const int &ring_id, const int &aid, const int &zid)
@@ -239,7 +388,7 @@ double Microball::GetThresholdKinergy(const int &ring_id, const int &aid, const
     {
         return DBL_MAX;
     }
-    return this->KinergyThresholdMap[{ring_id, aid, zid}];
+    return this->LookupThreshold(ring_id, aid, zid);
 }
 double Microball::GetThresholdKinergy(const double &thetalab, const int &aid, const int &zid)
 {
@@ -262,9 +411,7 @@ bool Microball::IsCovered(const double &thetalab, const double &phi)
     {
         return true;
     }
-    int ring_id = this->GetRingID(thetalab);
-    int det_id = this->GetDetID(thetalab, phi);
-    return (ring_id != -1 && det_id != -1);
+    return this->GetRingDetID(thetalab, phi).second != -1;
 }
 
 bool Microball::IsAccepted(const double &ekinlab, const double &thetalab, const int &aid, const int &zid)
@@ -274,78 +421,76 @@ bool Microball::IsAccepted(const double &ekinlab, const double &thetalab, const
         return true;
     }
     int ring_id = this->GetRingID(thetalab);
-    return (ring_id != -1 && aid <= this->MaxA && zid <= this->MaxZ) ? ekinlab >= this->KinergyThresholdMap[{ring_id, aid, zid}] : false;
+    return (ring_id != -1 && aid <= this->MaxA && zid <= this->MaxZ) ? ekinlab >= this->LookupThreshold(ring_id, aid, zid) : false;
 }
 
-void Microball::ResetCsIHitMap()
+void Microball::Accept(const std::size_t &n, const int *aid, const int *zid, const double *thetalab, const double *phi, const double *ekinlab, uint8_t *mask) const
 {
-    for (const auto &[ring_det, _] : this->CsIHitMap)
+    // same cuts as IsChargedParticle, IsCovered and IsAccepted, with one ring search per particle shared by the coverage and
+    // threshold cuts, and the threshold read from the flat table without a bounds branch
+    const int missing = this->KinergyThresholdTable.size() - 1;
+    const int table_A = this->ThresholdTableMaxA + 1;
+    const int table_Z = this->ThresholdTableMaxZ + 1;
+    for (std::size_t i = 0; i < n; i++)
     {
-        this->CsIHitMap[ring_det] = 0;
+        const int A = aid[i];
+        const int Z = zid[i];
+        int ring = FindInterval(this->RingIntervals, this->RingGrid, thetalab[i]);
+        bool covered = (ring != -1) && FindInterval(this->DetIntervals[ring], this->DetGrids[ring], phi[i]) != -1;
+
+        bool in_table = (ring >= 0) & (A >= 0) & (A < table_A) & (Z >= 0) & (Z < table_Z);
+        int index = in_table ? (ring * table_A + A) * table_Z + Z : missing;
+        bool above_threshold = (ring != -1) & (A <= MaxA) & (Z <= MaxZ) & (ekinlab[i] >= this->KinergyThresholdTable[index]);
+
+        bool pass_charge = !this->Is_apply_cut_charged_particle | (Z > 0);
+        bool pass_coverage = !this->Is_apply_cut_coverage | covered;
+        bool pass_threshold = !this->Is_apply_cut_kinergy | above_threshold;
+        mask[i] = pass_charge & pass_coverage & pass_threshold;
     }
+}
+
+void Microball::ResetCsIHitMap()
+{
+    std::memset(this->CsIHitCounts.data(), 0, sizeof(this->CsIHitCounts));
+    this->CsIHitMask.reset();
+    this->CsIHitTotal = 0;
     return;
 }
 
 int Microball::GetCsIHits()
 {
-    int Mch = 0;
-    for (auto &[ring_det, hits] : this->CsIHitMap)
+    // particles outside of the Microball, {-1, -1}, only count without the coverage cut
+    int outside = (!Is_apply_cut_coverage) ? this->CsIHitCounts[OutsideSlot] : 0;
+    if (!Is_apply_cut_multiple_hit)
     {
-        int ring = ring_det[0];
-        int det = ring_det[1];
-
-        if (!Is_apply_cut_multiple_hit)
-        {
-            if (ring == -1 && det == -1)
-            {
-                if (!Is_apply_cut_coverage)
-                    Mch += hits;
-            }
-            else
-            {
-                Mch += hits;
-            }
-        }
-        else
-        {
-            if (hits > 0)
-            {
-                if (ring == -1 && det == -1)
-                {
-                    if (!Is_apply_cut_coverage)
-                        Mch += 1;
-                }
-                else
-                {
-                    Mch += 1;
-                }
-            }
-        }
+        return this->CsIHitTotal + outside;
     }
-    return Mch;
+    // one count per hit CsI
+    int occupied = this->CsIHitMask.count() - this->CsIHitMask[OutsideSlot];
+    return occupied + (outside > 0 ? 1 : 0);
 }
 
 int Microball::GetCsIHits(const int &ring, const int &det)
 {
-    if (this->CsIHitMap.count({ring, det}) == 0)
+    if (ring < -1 || ring >= NumRing || det < -1 || det > NumDet)
     {
         return 0;
     }
-    return this->CsIHitMap[{ring, det}];
+    return this->CsIHitCounts[HitSlot(ring, det)];
 }
 
 void Microball::AddCsIHit(const double &thetalab, const double &phi)
 {
+    // a particle within the theta range of a ring but between its detectors is counted as {ring, -1}
     int ring_id = this->GetRingID(thetalab);
-    int det_id = this->GetDetID(thetalab, phi);
+    int det_id = (ring_id == -1) ? -1 : FindInterval(this->DetIntervals[ring_id], this->DetGrids[ring_id], phi);
 
-    if (this->CsIHitMap.count({ring_id, det_id}) == 0)
-    {
-        this->CsIHitMap[{ring_id, det_id}] = 1;
-    }
-    else if (this->CsIHitMap.count({ring_id, det_id}) == 1)
+    int slot = HitSlot(ring_id, det_id);
+    this->CsIHitCounts[slot]++;
+    this->CsIHitMask.set(slot);
+    if (slot != OutsideSlot)
     {
-        this->CsIHitMap[{ring_id, det_id}]++;
+        this->CsIHitTotal++;
     }
     return;
 }
@@ -7,12 +7,44 @@
 #include <tuple>
 #include <sstream>
 #include <map>
+#include <bitset>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
 #include <float.h>
+#include <cmath>
 #include <filesystem>
 namespace fs = std::filesystem;
 
 #include "TString.h"
 
+/**
+ * @brief Rows of the Microball database files, read once and shared by the setups of several reactions.
+ */
+struct MicroballDatabase
+{
+    struct GeometryRow
+    {
+        int ring, det;
+        double theta_min, theta_max, phi_min, phi_max;
+    };
+    struct ThresholdRow
+    {
+        int ring, A, Z;
+        double kinergy;
+    };
+
+    std::map<std::string, std::map<int, std::vector<int>>> setups; // reaction -> ring -> detector ids, config.dat
+    std::vector<GeometryRow> geometry;                              // geometry.dat
+    std::vector<ThresholdRow> thresholds;                           // fitted_threshold.dat
+    std::vector<std::string> files;                                 // files read, in order
+
+    void ReadConfig(const std::string &filename);
+    void ReadGeometry(const std::string &filename);
+    void ReadThreshold(const std::string &filename);
+};
+
 class Microball
 {
 protected:
@@ -41,6 +73,11 @@ public:
     void ReadThresholdKinergyMap(const std::string &filename);
     void ConfigurateSetup(const std::string &reaction, const std::string &filename);
 
+    // same as above from a database read once, e.g. for the setups of several reactions
+    void ReadGeometryMap(const MicroballDatabase &database);
+    void ReadThresholdKinergyMap(const MicroballDatabase &database);
+    void ConfigurateSetup(const std::string &reaction, const MicroballDatabase &database);
+
     // Getters for angles
     double GetThetaMin(const int &ring, const int &det) { return this->ThetaMap[ring][0]; }
     double GetThetaMax(const int &ring, const int &det) { return this->ThetaMap[ring][1]; }
@@ -71,13 +108,61 @@ public:
     bool IsCovered(const double &thetalab, const double &phi);
     bool IsAccepted(const double &ekinlab, const double &thetalab, const int &aid, const int &zid);
 
+    // charge, coverage and threshold cuts of n particles at once, mask[i] = 1 if particle i passes all of them
+    void Accept(const std::size_t &n, const int *aid, const int *zid, const double *thetalab, const double *phi, const double *ekinlab, uint8_t *mask) const;
+
     // check input information
     void ViewGeometryMap();
     void ViewThresholdKinergyMap();
     void ViewDetectorSetupMap();
 
 private:
-    std::map<std::array<int, 2>, int> CsIHitMap;
+    // angular range [low, high) of ring or detector id
+    struct Interval
+    {
+        double low, high;
+        int id;
+    };
+    // index of the interval containing value, -1 if none; intervals are sorted by low and disjoint
+    static int FindInterval(const std::vector<Interval> &intervals, const double &value);
+
+    // uniform grid over a set of intervals : each cell holds the id of the interval covering all of it, -1 if none, or Split
+    // when an interval boundary touches the cell; only values in split cells need the binary search
+    struct IntervalGrid
+    {
+        static constexpr int Split = -2;
+        static constexpr double CellWidth = 0.25; // degree
+        double origin = 0.;
+        std::vector<int> cells;
+    };
+    static IntervalGrid BuildGrid(const std::vector<Interval> &intervals);
+    static int FindInterval(const std::vector<Interval> &intervals, const IntervalGrid &grid, const double &value);
+    void BuildAngularLookup();
+
+    // lookup tables built from ThetaMap and PhiMap by ReadGeometryMap : rings sorted by theta, detectors of each ring sorted by phi
+    std::vector<Interval> RingIntervals;
+    std::array<std::vector<Interval>, NumRing> DetIntervals;
+    IntervalGrid RingGrid;
+    std::array<IntervalGrid, NumRing> DetGrids;
+    std::array<double, NumRing> PhiMinInRing;
+    std::array<double, NumRing> PhiMaxInRing;
+
+    // fitted thresholds as a flat [ring][A][Z] array built by ReadThresholdKinergyMap, bounded by the largest A and Z in the file,
+    // followed by one MissingThreshold entry that Accept() uses for (ring, A, Z) outside of the array
+    std::vector<double> KinergyThresholdTable;
+    int ThresholdTableMaxA = -1;
+    int ThresholdTableMaxZ = -1;
+    // (ring, A, Z) without a fitted threshold, e.g. A or Z beyond the file : no cut, as with the former map lookup
+    static constexpr double MissingThreshold = 0.;
+    double LookupThreshold(const int &ring, const int &aid, const int &zid) const;
+
+    // CsI hits of the current event, one slot per (ring, det) including the uncovered {ring, -1} and {-1, -1}
+    static constexpr int NumHitSlots = (NumRing + 1) * (NumDet + 2);
+    static constexpr int OutsideSlot = 0; // {-1, -1}
+    static int HitSlot(const int &ring, const int &det) { return (ring + 1) * (NumDet + 2) + det + 1; }
+    std::array<int, NumHitSlots> CsIHitCounts;
+    std::bitset<NumHitSlots> CsIHitMask; // slots with at least one hit
+    int CsIHitTotal;                     // hits in all slots but OutsideSlot
     std::map<int, std::array<double, 2>> ThetaMap;
     std::map<std::array<int, 2>, std::array<double, 2>> PhiMap;
     std::map<std::array<int, 3>, double> KinergyThresholdMap;
@@ -23,6 +23,12 @@ BaseHistograms::~BaseHistograms()
     }
 }
 
+void BaseHistograms::AddSpeciesHistogram(const int &species, TH2D *h2)
+{
+    this->Histogram2D_Collection[Species::GetName(species)] = h2;
+    this->Histogram2D_Species[species] = h2;
+}
+
 void BaseHistograms::Fill(const Particle &particle, const double &weight)
 {
     throw std::runtime_error("Histograms::Fill() is not implemented.");
@@ -4,11 +4,13 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <array>
 
 #include "TH1D.h"
 #include "TH2D.h"
 #include "TH3D.h"
 #include "Particle.hh"
+#include "Species.hh"
 
 class BaseHistograms
 {
@@ -24,26 +26,11 @@ public:
     std::map<std::string, TH2D *> Histogram2D_Collection;
     std::map<std::string, TH3D *> Histogram3D_Collection;
 
-protected:
-    std::vector<std::string> PARTICLENAMES = {
-        "n",
-        "p",
-        "d",
-        "t",
-        "3He",
-        "4He",
-        "coal_n",
-        "coal_p",
-    };
+    // the same histograms as in Histogram2D_Collection, indexed by Species::ID for Fill(), nullptr where there is none
+    std::array<TH2D *, Species::NumSpecies> Histogram2D_Species = {};
 
-    std::map<std::pair<int, int>, std::string> NUCLEINAMES = {
-        {{0, 1}, "n"},
-        {{1, 1}, "p"},
-        {{1, 2}, "d"},
-        {{1, 3}, "t"},
-        {{2, 3}, "3He"},
-        {{2, 4}, "4He"},
-    };
+protected:
+    void AddSpeciesHistogram(const int &species, TH2D *h2);
 };
 
 class ImpactParameterMultiplicity : public BaseHistograms
@@ -61,6 +48,7 @@ public:
 
 private:
     std::string frame;
+    bool frame_cms;
 };
 
 class PtRapidity : public BaseHistograms
@@ -3,21 +3,20 @@
 PmagEmissionTime::PmagEmissionTime(const std::string &suffix) : BaseHistograms(suffix)
 {
     this->name = "h2_PmagEmissionTime_" + suffix;
-    for (auto &pn : this->PARTICLENAMES)
+    for (int species = 0; species < Species::NumSpecies; species++)
     {
-        std::string hname = name + "_" + pn;
+        std::string hname = name + "_" + Species::GetName(species);
 
-        this->Histogram2D_Collection[pn] = new TH2D(hname.c_str(), "", 800, 0, 800., 500, 0, 500);
-        this->Histogram2D_Collection[pn]->Sumw2();
+        this->AddSpeciesHistogram(species, new TH2D(hname.c_str(), "", 800, 0, 800., 500, 0, 500));
+        this->Histogram2D_Species[species]->Sumw2();
     }
 }
 
 void PmagEmissionTime::Fill(const Particle &particle, const double &weight)
 {
-    std::string pn = this->NUCLEINAMES[{particle.Z, particle.A}];
-    if (this->Histogram2D_Collection.count(pn) == 1)
+    if (particle.species != Species::Unknown && this->Histogram2D_Species[particle.species])
     {
-        this->Histogram2D_Collection[pn]->Fill(particle.pmag_cms / particle.A, particle.t_cms, weight);
+        this->Histogram2D_Species[particle.species]->Fill(particle.pmag_cms / particle.A, particle.t_cms, weight);
     }
     return;
 }
@@ -25,25 +24,24 @@ void PmagEmissionTime::Fill(const Particle &particle, const double &weight)
 RmagEmissionTime::RmagEmissionTime(const std::string &suffix) : BaseHistograms(suffix)
 {
     this->name = "h2_RmagEmissionTime_" + suffix;
-    for (auto &pn : this->PARTICLENAMES)
+    for (int species = 0; species < Species::NumSpecies; species++)
     {
-        std::string hname = name + "_" + pn;
+        std::string hname = name + "_" + Species::GetName(species);
 
-        this->Histogram2D_Collection[pn] = new TH2D(hname.c_str(), "", 400, 0, 40., 500, 0, 500);
-        this->Histogram2D_Collection[pn]->Sumw2();
+        this->AddSpeciesHistogram(species, new TH2D(hname.c_str(), "", 400, 0, 40., 500, 0, 500));
+        this->Histogram2D_Species[species]->Sumw2();
     }
 }
 
 void RmagEmissionTime::Fill(const Particle &particle, const double &weight)
 {
-    std::string pn = this->NUCLEINAMES[{particle.Z, particle.A}];
-    if (this->Histogram2D_Collection.count(pn) == 1)
+    if (particle.species != Species::Unknown && this->Histogram2D_Species[particle.species])
     {
         double r_cms = TMath::Sqrt(
             particle.x * particle.x +
             particle.y * particle.y +
             particle.z_cms * particle.z_cms);
-        this->Histogram2D_Collection[pn]->Fill(r_cms, particle.t_cms, weight);
+        this->Histogram2D_Species[particle.species]->Fill(r_cms, particle.t_cms, weight);
     }
     return;
 }
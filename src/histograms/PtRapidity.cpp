@@ -3,33 +3,32 @@
 PtRapidity::PtRapidity(const std::string &suffix) : BaseHistograms(suffix)
 {
     this->name = "h2_PtRapidity_" + suffix;
-    for (auto &pn : this->PARTICLENAMES)
+    for (int species = 0; species < Species::NumSpecies; species++)
     {
-        this->Histogram2D_Collection[pn] = new TH2D((this->name + "_" + pn).c_str(), "", 300, -1.5, 1.5, 800, 0, 800);
-        this->Histogram2D_Collection[pn]->Sumw2();
+        std::string hname = this->name + "_" + Species::GetName(species);
+        this->AddSpeciesHistogram(species, new TH2D(hname.c_str(), "", 300, -1.5, 1.5, 800, 0, 800));
+        this->Histogram2D_Species[species]->Sumw2();
     }
 }
 
 void PtRapidity::Fill(const Particle &particle, const double &weight)
 {
-    std::string name = this->NUCLEINAMES[{particle.Z, particle.A}];
-
     double pta = particle.pmag_trans / particle.A;
     double normed_rapidity = particle.rapidity_lab_normed;
 
-    if (this->Histogram2D_Collection.count(name) == 1)
+    if (particle.species != Species::Unknown && this->Histogram2D_Species[particle.species])
     {
-        this->Histogram2D_Collection[name]->Fill(normed_rapidity, pta, weight);
+        this->Histogram2D_Species[particle.species]->Fill(normed_rapidity, pta, weight);
     }
 
     // fill coalescence
-    if (this->Histogram2D_Collection.count("coal_p") == 1)
+    if (this->Histogram2D_Species[Species::CoalescenceP])
     {
-        this->Histogram2D_Collection["coal_p"]->Fill(normed_rapidity, pta, weight * particle.Z);
+        this->Histogram2D_Species[Species::CoalescenceP]->Fill(normed_rapidity, pta, weight * particle.Z);
     }
-    if (Histogram2D_Collection.count("coal_n") == 1)
+    if (this->Histogram2D_Species[Species::CoalescenceN])
     {
-        this->Histogram2D_Collection["coal_n"]->Fill(normed_rapidity, pta, weight * particle.N);
+        this->Histogram2D_Species[Species::CoalescenceN]->Fill(normed_rapidity, pta, weight * particle.N);
     }
     return;
 }